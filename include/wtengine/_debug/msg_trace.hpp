@@ -0,0 +1,120 @@
+/*!
+ * wtengine | File:  msg_trace.hpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+#ifndef WTE_MSG_TRACE_HPP
+#define WTE_MSG_TRACE_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#include "wtengine/_debug/trace_format.hpp"
+#include "wtengine/_globals/_defines.hpp"
+#include "wtengine/_globals/engine_time.hpp"
+#include "wtengine/_globals/intern.hpp"
+#include "wtengine/_globals/message.hpp"
+
+namespace wte {
+
+class engine;
+
+namespace mgr {
+    class messages;
+}
+
+#if WTE_DEBUG_MODE  //  Debug mode set if true
+
+/*!
+ * \class msg_trace
+ * \brief Records processed and deleted messages to a binary trace file.
+ *
+ * Records are written to a ring buffer by the main thread and flushed
+ * to file by a background thread.  If the buffer is full the record is dropped.
+ * Use wte-tracedump to convert a trace to text.
+ * This option is built when the engine is in debug mode.
+ */
+class msg_trace final {
+    friend class engine;
+    friend class mgr::messages;
+
+    private:
+        msg_trace() = default;
+        ~msg_trace() = default;
+
+        //  Open the trace file and start the writer thread.
+        static const bool start(void);
+        //  Stop the writer thread, flush what is left and close the file.
+        static void stop(void);
+        //  Record a message event.  Main thread only.
+        static void record(const message& msg, const trace::message_event& event);
+
+        //  Writer thread loop.
+        static void run(void);
+        //  Write everything in the ring to the file.  Writer thread only.
+        static void flush(void);
+        //  Add an entry to the ring.  Returns false if there is no room.
+        static const bool push(const trace::entry_type& type, const std::vector<char>& body);
+        //  Add a string entry for an interned ID if not already written.
+        static const bool describe(const intern_id& id);
+
+        inline static constexpr std::size_t RING_SIZE = 1 << 20;  //  Must be a power of two.
+        inline static const std::string FILE_NAME = "wte_debug/messages.trace";
+
+        static std::vector<char> ring;             //  Trace ring buffer.
+        static std::atomic<std::size_t> head;      //  Bytes written by the main thread.
+        static std::atomic<std::size_t> tail;      //  Bytes flushed by the writer thread.
+        static std::vector<bool> described;        //  Interned IDs already written.
+        static std::vector<char> scratch;          //  Entry body being built.
+        static std::atomic<bool> _is_running;
+        static std::size_t _dropped;
+        static std::thread writer;
+        static std::ofstream trace_file;
+
+    public:
+        msg_trace(const msg_trace&) = delete;       //!<  Delete copy constructor.
+        void operator=(msg_trace const&) = delete;  //!<  Delete assignment operator.
+
+        static const std::size_t& dropped;  //!<  Records lost because the buffer was full.
+};
+
+#else  // not WTE_DEBUG_MODE
+
+/*!
+ * \class msg_trace
+ * \brief Skip message tracing.  This option is built when the engine is NOT in debug mode.
+ */
+class msg_trace final {
+    friend class engine;
+    friend class mgr::messages;
+
+    private:
+        msg_trace() = default;
+        ~msg_trace() = default;
+
+        inline static const bool start(void) { return false; };
+        inline static void stop(void) {};
+        inline static void record(const message& msg, const trace::message_event& event) {};
+
+    public:
+        msg_trace(const msg_trace&) = delete;       //!<  Delete copy constructor.
+        void operator=(msg_trace const&) = delete;  //!<  Delete assignment operator.
+
+        inline static const std::size_t dropped = 0;
+};
+
+#endif  //  WTE_DEBUG_MODE
+
+}  //  end namespace wte
+
+#endif  //  WTE_MSG_TRACE_HPP
@@ -0,0 +1,98 @@
+/*!
+ * wtengine | File:  trace_format.hpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+#ifndef WTE_TRACE_FORMAT_HPP
+#define WTE_TRACE_FORMAT_HPP
+
+#include <cstdint>
+
+/*
+ * Layout of a binary message trace file.  All values are little endian.
+ *
+ *   header
+ *   entries:  entry_header, followed by (size - sizeof(entry_header)) bytes of body.
+ *
+ * Entry bodies:
+ *   ENTRY_STRING:   uint32_t id, then the characters of the string (not NUL terminated).
+ *                   Written the first time an interned string is referenced.
+ *                   ID 0 is always the empty string and is never written.
+ *   ENTRY_MESSAGE:  message_record, then to_size bytes of the to name, from_size bytes
+ *                   of the from name and args_size bytes of arguments delimited by ;
+ *   ENTRY_DROPPED:  uint64_t count of entries lost because the trace buffer was full.
+ */
+namespace wte::trace {
+
+inline constexpr char MAGIC[4] = { 'W', 'T', 'E', 'T' };  //!<  File signature.
+inline constexpr uint32_t VERSION = 2;                     //!<  Current format version.
+
+inline constexpr uint32_t MAX_STRING = 1024;  //!<  Longer strings are truncated.
+inline constexpr uint32_t MAX_ARGS = 1024;    //!<  Longer arguments are truncated.
+
+/*!
+ * \enum entry_type
+ * Types of entries in a trace.
+ */
+enum entry_type : uint8_t {
+    ENTRY_STRING = 1,   //!<  Interned string definition.
+    ENTRY_MESSAGE = 2,  //!<  Message event.
+    ENTRY_DROPPED = 3   //!<  Count of dropped entries.
+};
+
+/*!
+ * \enum message_event
+ * What happened to a traced message.
+ */
+enum message_event : uint32_t {
+    EVENT_PROCESSED = 0,  //!<  Message was handed to its system.
+    EVENT_DELETED = 1     //!<  Message expired without being processed.
+};
+
+/*!
+ * \struct header
+ * \brief Start of a trace file.
+ */
+struct header {
+    char magic[4];     //!<  Must match MAGIC.
+    uint32_t version;  //!<  Format version.
+};
+
+/*!
+ * \struct entry_header
+ * \brief Start of each entry.
+ */
+struct entry_header {
+    uint16_t size;     //!<  Size of the entry, including this header.
+    uint8_t type;      //!<  An entry_type.
+    uint8_t reserved;  //!<  Unused, set to zero.
+};
+
+/*!
+ * \struct message_record
+ * \brief A traced message.  System and command are interned IDs.
+ */
+struct message_record {
+    int64_t proc_time;   //!<  Engine time the event happened.
+    int64_t timer;       //!<  Timer value of the message, -1 for untimed.
+    uint32_t sys;        //!<  System.
+    uint32_t cmd;        //!<  Command.
+    uint32_t to_size;    //!<  Bytes of the to name following the record.
+    uint32_t from_size;  //!<  Bytes of the from name following the to name.
+    uint32_t event;      //!<  A message_event.
+    uint32_t args_size;  //!<  Bytes of arguments following the record.
+};
+
+static_assert(sizeof(header) == 8, "Trace header must be 8 bytes.");
+static_assert(sizeof(entry_header) == 4, "Trace entry header must be 4 bytes.");
+static_assert(sizeof(message_record) == 40, "Trace message record must be 40 bytes.");
+static_assert(sizeof(entry_header) + sizeof(message_record) + 2 * MAX_STRING + MAX_ARGS <= UINT16_MAX,
+              "Trace entries must fit the entry size field.");
+
+}  //  end namespace wte::trace
+
+#endif
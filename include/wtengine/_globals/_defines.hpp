@@ -11,6 +11,7 @@
 #define WTE_GLOBAL_DEFINES_HPP
 
 #include <type_traits>
+#include <cstdint>
 
 //  Enable math defines for entire engine.
 #ifndef _USE_MATH_DEFINES
@@ -55,6 +56,14 @@
 #define WTE_MAX_PLAYING_SAMPLES (8)
 #endif
 
+/*!
+ * Number of ticks an entity must be idle before it is put to sleep.
+ * Set to 0 to disable automatic sleeping.
+ */
+#ifndef WTE_ENTITY_SLEEP_TICKS
+#define WTE_ENTITY_SLEEP_TICKS (0)
+#endif
+
 /*!
  * Enable magic pink for transparency if WTE_NO_MAGIC_PINK is not defined.
  */
@@ -64,6 +73,15 @@
 #define WTE_USE_MAGIC_PINK FALSE
 #endif
 
+/*!
+ * Draw frames on a separate render thread if WTE_ENABLE_RENDER_THREAD is defined.
+ */
+#ifdef WTE_ENABLE_RENDER_THREAD
+#define WTE_RENDER_THREAD TRUE
+#else
+#define WTE_RENDER_THREAD FALSE
+#endif
+
 namespace wte {
 
 /*!
@@ -76,6 +94,8 @@ struct wte_build_options {
     inline constexpr static bool debug_mode = static_cast<bool>(WTE_DEBUG_MODE);
     inline constexpr static int max_playing_samples = static_cast<int>(WTE_MAX_PLAYING_SAMPLES);
     inline constexpr static bool use_magic_pink = static_cast<bool>(WTE_USE_MAGIC_PINK);
+    inline constexpr static int64_t entity_sleep_ticks = static_cast<int64_t>(WTE_ENTITY_SLEEP_TICKS);
+    inline constexpr static bool render_thread = static_cast<bool>(WTE_RENDER_THREAD);
 
     //  Input options
     inline constexpr static bool keyboard_enabled = static_cast<bool>(true);
@@ -11,10 +11,10 @@
 #define WTE_COMMANDS_HPP
 
 #include <string>
-#include <map>
-#include <utility>
+#include <vector>
 #include <functional>
 
+#include "wtengine/_globals/intern.hpp"
 #include "wtengine/_globals/message.hpp"
 
 namespace wte {
@@ -22,6 +22,10 @@ namespace wte {
 /*!
  * \class commands
  * \brief Container for storing engine commands expressed as a lambda.
+ * 
+ * Commands are stored sorted by the interned ID of their name,
+ * so looking up a message's command is a binary search over
+ * only the commands this table holds.
  */
 class commands final {
     public:
@@ -41,6 +45,29 @@ class commands final {
             const std::function<void(const msg_args&)>& func
         );
 
+        /*!
+         * \brief Add a command that reads the whole message.
+         * 
+         * Use to access the message's typed payload.
+         * 
+         * \param cmd Command name to run.
+         * \param nargs Minimum number of expected arguments.
+         * \param func Lambda expression to run.
+         * \return True on sucess, false on fail.
+         */
+        const bool add(
+            const std::string& cmd,
+            const std::size_t& nargs,
+            const std::function<void(const message&)>& func
+        );
+
+        /*!
+         * \brief Check if a command is registered.
+         * \param cmd ID of the command name.
+         * \return True if registered, false if not.
+         */
+        const bool contains(const intern_id& cmd) const;
+
         /*!
          * \brief Process a list of messages.
          * \param messages List of messages to process.
@@ -48,13 +75,18 @@ class commands final {
         void process_messages(const message_container& messages);
 
     private:
-        //  Container for commands.
-        std::map<
-            std::string,
-            std::pair<
-                std::size_t,
-                std::function<void(const msg_args&)>
-        >> _commands;
+        //  A registered command.
+        struct command {
+            intern_id id;                                 //  ID of the command name.
+            std::size_t nargs;                            //  Minimum number of arguments.
+            std::function<void(const message&)> func;     //  Command to run.
+        };
+
+        //  Find a command by ID, nullptr if not registered.
+        const command* find(const intern_id& cmd) const;
+
+        //  Container for commands, sorted by the ID of the command name.
+        std::vector<command> _commands;
 };
 
 }  //  end namespace wte
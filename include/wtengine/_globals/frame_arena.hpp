@@ -0,0 +1,157 @@
+/*!
+ * wtengine | File:  frame_arena.hpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+#ifndef WTE_FRAME_ARENA_HPP
+#define WTE_FRAME_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+namespace wte {
+
+/*!
+ * \class frame_arena
+ * \brief Bump allocator for temporaries that only live for one frame.
+ * 
+ * Memory is handed out from a single buffer and released all at once
+ * when the engine resets the arena at the end of each pass of the game loop.
+ * The buffer grows to the largest frame seen, so steady state frames
+ * do not touch the heap.
+ * 
+ * Only the main thread allocates from the arena.  Other threads fall back
+ * to the heap, so frame containers may still be used from them.
+ * Each allocation is tagged with where it came from, so heap memory
+ * is released and arena memory is left for the reset.
+ *
+ * Arena memory must not be used after the reset, so containers allocated
+ * from the main thread must not outlive the frame.  In debug builds the
+ * reset logs any arena allocations that have not been released.
+ */
+class frame_arena final {
+    friend class engine;
+
+    public:
+        frame_arena() = delete;                       //!<  Delete constructor.
+        ~frame_arena() = delete;                      //!<  Delete destructor.
+        frame_arena(const frame_arena&) = delete;     //!<  Delete copy constructor.
+        void operator=(frame_arena const&) = delete;  //!<  Delete assignment operator.
+
+        /*!
+         * \brief Allocate memory for this frame.
+         * \param bytes Number of bytes.
+         * \param align Alignment of the memory.
+         * \return Pointer to the memory.
+         */
+        static void* allocate(const std::size_t& bytes, const std::size_t& align);
+
+        /*!
+         * \brief Release memory.
+         * 
+         * Heap memory is freed.  Arena memory is reclaimed when the arena resets.
+         * 
+         * \param ptr Pointer to the memory.
+         * \param bytes Number of bytes.
+         * \param align Alignment of the memory.
+         */
+        static void deallocate(void* ptr, const std::size_t& bytes, const std::size_t& align);
+
+        static const std::size_t& capacity;  //!<  Size of the arena buffer in bytes.
+
+    private:
+        //  Release all frame memory.  Called by the engine at the end of each frame.
+        static void reset(void);
+
+        //  Written just before each allocation.
+        struct header {
+            uint64_t origin;  //  FROM_ARENA or FROM_HEAP.
+        };
+        inline static constexpr uint64_t FROM_ARENA = 0x414E4552415F4557;
+        inline static constexpr uint64_t FROM_HEAP = 0x504145485F45544D;
+
+        //  Bytes in front of an allocation used for its header, keeping the alignment.
+        inline static constexpr std::size_t header_space(const std::size_t& align) {
+            return (sizeof(header) + align - 1) & ~(align - 1);
+        };
+        //  Alignment of heap allocations, so the header is aligned too.
+        inline static constexpr std::size_t heap_align(const std::size_t& align) {
+            return (align > alignof(header) ? align : alignof(header));
+        };
+        //  Write the header of an allocation.
+        static void set_origin(void* ptr, const uint64_t& origin);
+
+        static unsigned char* buffer;   //  Main buffer
+        static std::size_t _capacity;   //  Size of the main buffer
+        static std::size_t offset;      //  Next free byte in the main buffer
+        //  Extra blocks used when the main buffer fills during a frame.
+        static std::vector<std::pair<unsigned char*, std::size_t>> overflow;
+        static std::size_t overflow_used;  //  Bytes allocated from overflow blocks
+        static std::atomic<std::size_t> live;  //  Arena allocations not yet released, debug builds only
+
+        static const std::thread::id main_thread;  //  Only thread using the arena
+};
+
+/*!
+ * \class frame_allocator
+ * \brief Allocator for standard containers backed by the frame arena.
+ * 
+ * Containers using this allocator are only valid until the end of the frame
+ * when used from the main thread.
+ * 
+ * \tparam T Type to allocate.
+ */
+template <typename T>
+class frame_allocator {
+    public:
+        typedef T value_type;  //!<  Allocated type.
+
+        frame_allocator() noexcept = default;  //!<  Default constructor.
+
+        /*!
+         * \brief Rebind copy constructor.
+         */
+        template <typename U>
+        frame_allocator(const frame_allocator<U>&) noexcept {};
+
+        /*!
+         * \brief Allocate memory for n objects.
+         * \param n Number of objects.
+         * \return Pointer to the memory.
+         */
+        inline T* allocate(const std::size_t n) {
+            return static_cast<T*>(frame_arena::allocate(n * sizeof(T), alignof(T)));
+        };
+
+        /*!
+         * \brief Release memory for n objects.
+         * \param ptr Pointer to the memory.
+         * \param n Number of objects.
+         */
+        inline void deallocate(T* ptr, const std::size_t n) noexcept {
+            frame_arena::deallocate(ptr, n * sizeof(T), alignof(T));
+        };
+};
+
+/*!
+ * \brief All frame allocators share the same arena.
+ */
+template <typename T, typename U>
+inline bool operator==(const frame_allocator<T>&, const frame_allocator<U>&) { return true; };
+
+/*!
+ * \brief All frame allocators share the same arena.
+ */
+template <typename T, typename U>
+inline bool operator!=(const frame_allocator<T>&, const frame_allocator<U>&) { return false; };
+
+}  //  end namespace wte
+
+#endif
@@ -0,0 +1,71 @@
+/*!
+ * wtengine | File:  intern.hpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+#ifndef WTE_INTERN_HPP
+#define WTE_INTERN_HPP
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+
+namespace wte {
+
+/*!
+ * \typedef std::size_t intern_id
+ * ID of an interned string.
+ */
+typedef std::size_t intern_id;
+
+/*!
+ * \class intern
+ * \brief Maps strings to unique IDs so they can be compared and hashed cheaply.
+ * 
+ * IDs are never released, so only intern names from a bounded set
+ * (system names, commands).  Entity names are not bounded and must not be interned.
+ */
+class intern final {
+    public:
+        intern() = delete;                       //!<  Delete constructor.
+        ~intern() = delete;                      //!<  Delete destructor.
+        intern(const intern&) = delete;          //!<  Delete copy constructor.
+        void operator=(intern const&) = delete;  //!<  Delete assignment operator.
+
+        /*!
+         * \brief Get the ID of a string, adding it to the table if needed.
+         * \param str String to look up.
+         * \return ID of the string.
+         */
+        static const intern_id id(const std::string& str);
+
+        /*!
+         * \brief Get the string an ID refers to.
+         * \param i ID to look up.
+         * \return The string.  Empty string if the ID is not valid.
+         */
+        static const std::string& str(const intern_id& i);
+
+        inline static const intern_id EMPTY = 0;  //!<  ID of the empty string.
+
+    private:
+        //  Table storage, created on first use so it is safe to
+        //  intern strings during static initialization.
+        struct table {
+            table() { strings.push_back(""); ids.insert(std::make_pair("", EMPTY)); };
+
+            std::deque<std::string> strings;                  //  Strings by ID.
+            std::unordered_map<std::string, intern_id> ids;   //  IDs by string.
+            std::mutex mtx;
+        };
+        static table& get_table(void);
+};
+
+}  //  end namespace wte
+
+#endif
@@ -11,20 +11,58 @@
 #define WTE_MSG_MESSAGE_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <variant>
+
+#include "wtengine/_globals/frame_arena.hpp"
+#include "wtengine/_globals/intern.hpp"
+#include "wtengine/_globals/wte_asset.hpp"
 
 namespace wte {
 
+class al_bitmap;
+class al_font;
+class al_sample;
+class al_audio;
+
 /*!
  * \typedef std::vector<std::string> msg_args
  * Container to store each message argument separately.
  */
 typedef std::vector<std::string> msg_args;
 
+/*!
+ * \typedef msg_value
+ * A single typed payload value.  std::size_t values are entity IDs.
+ */
+typedef std::variant<
+    std::monostate,
+    bool,
+    int64_t,
+    float,
+    std::size_t,
+    wte_asset<al_bitmap>,
+    wte_asset<al_font>,
+    wte_asset<al_sample>,
+    wte_asset<al_audio>
+> msg_value;
+
+/*!
+ * \typedef std::vector<msg_value> msg_payload
+ * Container to store the typed payload of a message.
+ */
+typedef std::vector<msg_value> msg_payload;
+
 /*!
  * \class message
  * \brief Define individual message objects.
+ * 
+ * The system and command fields are stored as interned IDs.
+ * To and from are entity names, which are not interned since entities come and go.
+ * Arguments are kept in a single buffer and only split when requested.
  */
 class message final {
     public:
@@ -90,6 +128,24 @@ class message final {
             const std::string& a
         );
 
+        /*!
+         * \brief Create a message from interned system and command values.
+         * \param e Timer value.
+         * \param s System ID.
+         * \param t To.
+         * \param f From.
+         * \param c Command ID.
+         * \param a Arguments delimited by ;
+         */
+        message(
+            const int64_t& e,
+            const intern_id& s,
+            const std::string& t,
+            const std::string& f,
+            const intern_id& c,
+            const std::string& a
+        );
+
         /*!
          * \brief Overload < operator to sort by timer value.
          * \param m Object to compare to.
@@ -107,25 +163,37 @@ class message final {
          * \brief Get system value.
          * \return The value of sys.
          */
-        const std::string get_sys(void) const;
+        const std::string& get_sys(void) const;
+
+        /*!
+         * \brief Get the interned ID of the system value.
+         * \return The ID of sys.
+         */
+        const intern_id get_sys_id(void) const;
 
         /*!
          * \brief Get to value.
          * \return The value of to.
          */
-        const std::string get_to(void) const;
+        const std::string& get_to(void) const;
 
         /*!
          * \brief Get from value.
          * \return The value of from.
          */
-        const std::string get_from(void) const;
+        const std::string& get_from(void) const;
 
         /*!
          * \brief Get command value.
          * \return The value of cmd.
          */
-        const std::string get_cmd(void) const;
+        const std::string& get_cmd(void) const;
+
+        /*!
+         * \brief Get the interned ID of the command value.
+         * \return The ID of cmd.
+         */
+        const intern_id get_cmd_id(void) const;
 
         /*!
          * \brief Get number of arguments.
@@ -135,9 +203,12 @@ class message final {
 
         /*!
          * \brief Get the arguments split into a vector.
+         * 
+         * The arguments are split on the first call and kept with the message.
+         * 
          * \return The vector of the arguments.
          */
-        const msg_args get_args(void) const;
+        const msg_args& get_args(void) const;
 
         /*!
          * \brief Returns a single argument by pos from the argument list.
@@ -146,6 +217,46 @@ class message final {
          */
         const std::string get_arg(const std::size_t& pos) const;
 
+        /*!
+         * \brief View a single argument by pos without copying it.
+         * 
+         * The view is valid for the lifetime of the message.
+         * 
+         * \param pos The position in the argument list.
+         * \return View of the argument.  Empty if out of range.
+         */
+        const std::string_view arg(const std::size_t& pos) const;
+
+        /*!
+         * \brief Attach a typed payload to the message.
+         * 
+         * The payload is carried alongside the string arguments
+         * so handlers can read values without parsing them.
+         * Payload positions match argument positions.
+         * 
+         * \param p Payload values.
+         * \return Reference to this message.
+         */
+        message& set_payload(const msg_payload& p);
+
+        /*!
+         * \brief Get the typed payload.
+         * \return The payload values.
+         */
+        const msg_payload& get_payload(void) const;
+
+        /*!
+         * \brief Read a payload value by position and type.
+         * \tparam T Type of value to read.
+         * \param pos Position in the payload.
+         * \return Pointer to the value, nullptr if out of range or not of type T.
+         */
+        template <typename T>
+        inline const T* get_value(const std::size_t& pos) const {
+            if(pos >= payload.size()) return nullptr;
+            return std::get_if<T>(&payload[pos]);
+        };
+
         /*!
          * \brief Check if the event is synced to the timer.
          * \return Returns false if the timer value is -1, else true.
@@ -153,22 +264,27 @@ class message final {
         const bool is_timed_event(void) const;
 
     private:
-        //  Split arguments into a vector of strings.
-        void split_args(const std::string& a);
+        //  Store the argument buffer, dropping a trailing delimiter.
+        void set_args(const std::string& a);
 
         int64_t timer;      //  Timer value that the message will be processed at
-        std::string sys;    //  System that will process the message
+        intern_id sys;      //  System that will process the message
         std::string to;     //  Message to entity field
         std::string from;   //  Message from entity field
-        std::string cmd;    //  Message command
-        msg_args args;      //  Message arguments
+        intern_id cmd;      //  Message command
+        std::string args;   //  Message arguments, delimited by ;
+        msg_payload payload;  //  Typed payload values
+
+        mutable msg_args split_cache;   //  Arguments split by get_args
+        mutable bool is_split;          //  If split_cache is filled
 };
 
 /*!
- * \typedef std::vector<message> message_container
+ * \typedef std::vector<message, frame_allocator<message>> message_container
  * Container to store a collection of messages.
+ * Allocated from the frame arena, only valid until the end of the frame.
  */
-typedef std::vector<message> message_container;
+typedef std::vector<message, frame_allocator<message>> message_container;
 
 }  //  end namespace wte
 
@@ -0,0 +1,92 @@
+/*!
+ * wtengine | File:  script_format.hpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+#ifndef WTE_SCRIPT_FORMAT_HPP
+#define WTE_SCRIPT_FORMAT_HPP
+
+#include <cstdint>
+
+/*
+ * Layout of an indexed script file.  All values are little endian.
+ *
+ *   header
+ *   string table:  uint32_t offsets[string_count], then the NUL terminated strings.
+ *                  Offsets are relative to the start of the strings.
+ *                  String 0 is always the empty string.
+ *   records:       record[record_count], sorted by timer.  Untimed (-1) records first.
+ *   payload:       value[payload_count], in record order.
+ */
+namespace wte::script {
+
+inline constexpr char MAGIC[4] = { 'W', 'T', 'E', 'S' };  //!<  File signature.
+inline constexpr uint32_t VERSION = 1;                     //!<  Current format version.
+
+/*!
+ * \enum value_type
+ * Types of payload values that can be stored in a script.
+ */
+enum value_type : uint32_t {
+    VALUE_NONE = 0,   //!<  Empty value, holds the place of a string argument.
+    VALUE_BOOL = 1,   //!<  Boolean, stored in int_value.
+    VALUE_INT = 2,    //!<  Integer, stored in int_value.
+    VALUE_FLOAT = 3   //!<  Float, stored in float_value.
+};
+
+/*!
+ * \struct header
+ * \brief Start of an indexed script file.
+ */
+struct header {
+    char magic[4];            //!<  Must match MAGIC.
+    uint32_t version;         //!<  Format version.
+    uint32_t string_count;    //!<  Number of strings in the string table.
+    uint32_t record_count;    //!<  Number of message records.
+    uint32_t payload_count;   //!<  Number of payload values.
+    uint32_t reserved;        //!<  Unused, set to zero.
+    uint64_t string_offset;   //!<  File position of the string table.
+    uint64_t record_offset;   //!<  File position of the records.
+    uint64_t payload_offset;  //!<  File position of the payload values.
+};
+
+/*!
+ * \struct record
+ * \brief A single message.  Strings are indexes into the string table.
+ */
+struct record {
+    int64_t timer;           //!<  Timer value, -1 for untimed.
+    uint32_t sys;            //!<  System.
+    uint32_t to;             //!<  To.
+    uint32_t from;           //!<  From.
+    uint32_t cmd;            //!<  Command.
+    uint32_t args;           //!<  Arguments delimited by ;
+    uint32_t payload_start;  //!<  First payload value.
+    uint32_t payload_count;  //!<  Number of payload values.
+    uint32_t reserved;       //!<  Unused, set to zero.
+};
+
+/*!
+ * \struct value
+ * \brief A typed payload value.
+ */
+struct value {
+    uint32_t type;            //!<  A value_type.
+    uint32_t reserved;        //!<  Unused, set to zero.
+    union {
+        int64_t int_value;    //!<  Bool or integer value.
+        float float_value;    //!<  Float value.
+    };
+};
+
+static_assert(sizeof(header) == 48, "Script header must be 48 bytes.");
+static_assert(sizeof(record) == 40, "Script record must be 40 bytes.");
+static_assert(sizeof(value) == 16, "Script value must be 16 bytes.");
+
+}  //  end namespace wte::script
+
+#endif
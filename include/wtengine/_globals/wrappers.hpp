@@ -109,6 +109,25 @@ class al_bitmap final {
          */
         const int get_height(void) const;
 
+        /*!
+         * \brief Move the bitmap into a region of an atlas bitmap.
+         * 
+         * The bitmap is copied into the atlas at x, y and replaced by a
+         * sub-bitmap of that region.  The atlas must outlive the bitmap.
+         * 
+         * \param atlas Atlas bitmap to copy into.
+         * \param x X position in the atlas.
+         * \param y Y position in the atlas.
+         * \return True if moved, false on error.
+         */
+        const bool pack(ALLEGRO_BITMAP* atlas, const int& x, const int& y);
+
+        /*!
+         * \brief Check if the bitmap is a region of an atlas.
+         * \return True if packed, false if not.
+         */
+        const bool ispacked(void) const;
+
     private:
         ALLEGRO_BITMAP* _al_bitmap;  //  Internal Allegro bitmap.
         bool nopreserve;             //  Preservation flag.
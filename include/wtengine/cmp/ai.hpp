@@ -28,6 +28,8 @@ namespace wte::cmp {
  * \brief Tag components to be processed by the Logic system.
  * 
  * Allows functions to be created to define the enabled or disabled logic.
+ * The logic system runs without the display, so these functions must not
+ * create, load or draw to bitmaps.  Send a message to do that instead.
  */
 class ai final : public component {
     friend class sys::logic;
@@ -51,12 +53,13 @@ class ai final : public component {
 
         ai() = delete;    //!<  Delete default constructor.
         ~ai() = default;  //!<  Default destructor.
+        ai& operator=(ai&&) = default;  //!<  Default move assignment.
 
         bool enabled;     //!<  Flag to enable or disable the entity.
 
     private:
-        const std::function<void(const entity_id&)> enabled_ai;   //  AI to run when enabled.
-        const std::function<void(const entity_id&)> disabled_ai;  //  AI to run when disabled.
+        std::function<void(const entity_id&)> enabled_ai;   //  AI to run when enabled.
+        std::function<void(const entity_id&)> disabled_ai;  //  AI to run when disabled.
 };
 
 }  //  end namespace wte::cmp
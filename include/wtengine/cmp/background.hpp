@@ -58,6 +58,7 @@ class background final : public gfx {
 
         background() = delete;    //!<  Delete default constructor.
         ~background() = default;  //!<  Default destructor.
+        background& operator=(background&&) = default;  //!<  Default move assignment.
 
         float pos_x;  //!<  X position.
         float pos_y;  //!<  Y position.
@@ -38,6 +38,7 @@ class bounding_box final : public component {
 
         bounding_box() = delete;    //!<  Delete default constructor.
         ~bounding_box() = default;  //!<  Default destructor.
+        bounding_box& operator=(bounding_box&&) = default;  //!<  Default move assignment.
 
         float min_x;  //!<  Top left X position of bounding box.
         float min_y;  //!<  Top left Y position of bounding box.
@@ -42,10 +42,11 @@ class dispatcher final : public component {
 
         dispatcher() = delete;    //!<  Delete default constructor.
         ~dispatcher() = default;  //!<  Default destructor.
+        dispatcher& operator=(dispatcher&&) = default;  //!<  Default move assignment.
 
     private:
         //  Message handler.
-        const std::function<void(const entity_id&, const message&)> handle_msg;
+        std::function<void(const entity_id&, const message&)> handle_msg;
 };
 
 }  //  end namespace wte::cmp
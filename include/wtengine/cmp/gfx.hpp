@@ -53,6 +53,8 @@ class gfx : public component {
 
         /*!
          * \brief Set drawing to the internal bitmap.
+         * 
+         * Draw to the bitmap through this, so the renderer knows it changed.
          */
         void set_drawing(void);
 
@@ -93,15 +95,44 @@ class gfx : public component {
             const std::function<void(const entity_id&)>& func
         );
 
+        /*!
+         * \brief Extend to create a gfx component that animates itself.
+         * 
+         * The function is passed the component, so it stays correct when the
+         * component is moved.  Do not capture this in it.
+         * 
+         * \param bmp Bitmap asset to use.
+         * \param l Layer position.
+         * \param func Animation function.
+         */
+        gfx(
+            wte_asset<al_bitmap> bmp,
+            const std::size_t& l,
+            const std::function<void(const entity_id&, gfx&)>& func
+        );
+
+        gfx& operator=(gfx&&) = default;  //!<  Default move assignment.
+
         //!  Stores the bitmap used by the animator.
         wte_asset<al_bitmap> _bitmap;
 
+        /*!
+         * \brief Check if the animation needs to run this tick.
+         * 
+         * Called by the animate system before running the animation.
+         * Override to skip redrawing when nothing changed.
+         * 
+         * \return True to run the animation.
+         */
+        virtual const bool needs_redraw(void) { return true; };
+
     private:
+        std::size_t revision;      //  Counts calls to set_drawing, for cached drawing.
         bool tinted;               //  Flag to set tint.
         ALLEGRO_COLOR tint_color;  //  Color of tint.
 
-        //  Animation function.
-        const std::function<void(const entity_id&)> animate;
+        //  Animation function, passed the component it animates.
+        std::function<void(const entity_id&, gfx&)> animate;
 };
 
 /*!
@@ -48,6 +48,7 @@ class hitbox final : public component {
 
         hitbox() = delete;    //!<  Delete default constructor.
         ~hitbox() = default;  //!<  Default destructor.
+        hitbox& operator=(hitbox&&) = default;  //!<  Default move assignment.
 
         float width;       //!<  Width of the hitbox.
         float height;      //!<  Height of the hitbox.
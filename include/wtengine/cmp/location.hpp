@@ -32,6 +32,7 @@ class location final : public component {
 
         location() = delete;    //!<  Delete default constructor.
         ~location() = default;  //!<  Default destructor.
+        location& operator=(location&&) = default;  //!<  Default move assignment.
 
         float pos_x;  //!<  Entity X location.
         float pos_y;  //!<  Entity Y location.
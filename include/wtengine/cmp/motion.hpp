@@ -10,8 +10,14 @@
 #ifndef WTE_CMP_MOTION_HPP
 #define WTE_CMP_MOTION_HPP
 
+#include <cmath>
+
 #include "wtengine/cmp/component.hpp"
 
+namespace wte::sys {
+    class movement;
+}
+
 namespace wte::cmp {
 
 /*!
@@ -19,6 +25,8 @@ namespace wte::cmp {
  * \brief Store motion information (velocity and direction) of an entity.
  */
 class motion final : public component {
+    friend class sys::movement;
+
     public:
         /*!
          * \brief Create a new Motion component with set direction and velocity.
@@ -34,10 +42,17 @@ class motion final : public component {
 
         motion() = delete;    //!<  Delete default constructor.
         ~motion() = default;  //!<  Default destructor.
+        motion& operator=(motion&&) = default;  //!<  Default move assignment.
 
         float direction;  //!<  Angle of direction.
         float x_vel;      //!<  X velocity.
         float y_vel;      //!<  Y velocity.
+
+    private:
+        //  Direction the cached unit vector was calculated for.
+        float cached_direction;
+        //  Cached cos/sin of the direction, updated by the movement system.
+        float dir_x, dir_y;
 };
 
 }  //  end namespace wte::cmp
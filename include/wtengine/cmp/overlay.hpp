@@ -12,12 +12,15 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <utility>
 #include <functional>
 
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_font.h>
 
 #include "wtengine/cmp/gfx.hpp"
+#include "wtengine/mgr/variables.hpp"
 
 namespace wte::cmp::gfx {
 
@@ -48,6 +51,7 @@ class overlay final : public gfx {
 
         overlay() = delete;    //!<  Delete default constructor.
         ~overlay() = default;  //!<  Default destructor.
+        overlay& operator=(overlay&&) = default;  //!<  Default move assignment.
 
         /*!
          * \brief Draw text on the overlay.
@@ -65,11 +69,35 @@ class overlay final : public gfx {
             const int& f
         );
 
+        /*!
+         * \brief Redraw the overlay when a game variable changes.
+         * 
+         * Once an overlay has bound variables or been invalidated, its animation
+         * only runs when one of them changes or it is invalidated again.
+         * Overlays that do neither are redrawn every tick.
+         * 
+         * \param var Variable name.
+         */
+        void bind(const std::string& var);
+
+        /*!
+         * \brief Redraw the overlay on the next tick.
+         */
+        void invalidate(void);
+
         float pos_x;  //!<  X position.
         float pos_y;  //!<  Y position.
 
     private:
+        //  Check for changes since the last redraw.
+        const bool needs_redraw(void) override;
+
         wte_asset<al_font> overlay_font;  //  Font for overlay.
+
+        bool tracked;      //  Only redraw on changes.
+        bool invalidated;  //  Redraw on the next tick.
+        //  Bound variables and their revision when last drawn.
+        std::vector<std::pair<std::string, std::size_t>> bindings;
 };
 
 }  //  end namespace wte::cmp
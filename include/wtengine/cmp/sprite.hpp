@@ -12,7 +12,12 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 #include <map>
+#include <tuple>
+#include <memory>
+#include <mutex>
+#include <algorithm>
 #include <stdexcept>
 
 #include <allegro5/allegro.h>
@@ -31,9 +36,27 @@ namespace wte::mgr::gfx {
 
 namespace wte::cmp::gfx {
 
+/*!
+ * \struct frame_region
+ * \brief Position of a single frame in a sprite sheet.
+ */
+struct frame_region {
+    float x;  //!<  X position of the frame.
+    float y;  //!<  Y position of the frame.
+};
+
+/*!
+ * \typedef std::vector<frame_region> frame_table
+ * Positions of each frame in a sprite sheet, by frame number.
+ */
+typedef std::vector<frame_region> frame_table;
+
 /*!
  * \class sprite
  * \brief Component for loading a sprite sheet and storing its animation frames.
+ * 
+ * Frame positions are computed once per sheet layout and shared by all
+ * sprites using it.  The renderer draws the current frame straight from the sheet.
  */
 class sprite final : public gfx {
     friend class mgr::gfx::renderer;
@@ -60,6 +83,7 @@ class sprite final : public gfx {
 
         sprite() = delete;    //!<  Delete default constructor.
         ~sprite() = default;  //!<  Default destructor.
+        sprite& operator=(sprite&&) = default;  //!<  Default move assignment.
 
         /*!
          * \brief Add animation cycle.
@@ -81,7 +105,24 @@ class sprite final : public gfx {
          */
         const bool set_cycle(const std::string& name);
 
+        /*!
+         * \brief Get the current animation frame.
+         * \return Frame number.
+         */
+        const std::size_t get_frame(void) const;
+
     private:
+        //  Get the shared frame table for a sheet layout, building it if needed.
+        static const std::shared_ptr<const frame_table> get_frames(
+            const int& sw, const int& sh, const float& fw, const float& fh);
+
+        //  Frame tables in use, by sheet size and frame size.
+        static std::map<
+            const std::tuple<int, int, float, float>,
+            std::weak_ptr<const frame_table>
+        > frame_tables;
+        static std::mutex frame_mtx;
+
         //  Animation cycle index.
         std::map<
             const std::string,
@@ -94,6 +135,7 @@ class sprite final : public gfx {
         int sheet_width, sheet_height;          //  Sprite sheet size (w/h).
         std::size_t start_frame, stop_frame;    //  Current start/stop frame postitions.
         std::size_t current_frame, rate;        //  Current frame counter and frame rate.
+        std::shared_ptr<const frame_table> frames;  //  Frame positions for the sheet.
 };
 
 }  //  end namespace wte::cmp
@@ -21,6 +21,7 @@
 #include <allegro5/allegro_opengl.h>
 #include <allegro5/allegro_image.h>
 #include <allegro5/allegro_font.h>
+#include <allegro5/allegro_primitives.h>
 #include <allegro5/allegro_audio.h>
 #include <allegro5/allegro_physfs.h>
 #include <physfs.h>
@@ -31,6 +32,7 @@
 
 #include "wtengine/_debug/exceptions.hpp"
 #include "wtengine/_debug/logger.hpp"
+#include "wtengine/_debug/msg_trace.hpp"
 #include "wtengine/_globals/_defines.hpp"
 #include "wtengine/_globals/commands.hpp"
 #include "wtengine/_globals/engine_time.hpp"
@@ -13,6 +13,8 @@
 #include <string>
 #include <tuple>
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <exception>
 
 #include <allegro5/allegro.h>
@@ -27,6 +29,7 @@
 
 namespace wte {
     class display;
+    class al_bitmap;
     //class al_bitmap_converter;
 }
 
@@ -108,10 +111,73 @@ class assets final : private manager<assets<>> {
             }
         };
 
+        /*!
+         * \brief Pack loaded bitmaps into texture atlases.
+         * 
+         * Each bitmap is copied into a shared atlas texture and becomes a region
+         * of it.  Existing asset handles keep working, and the renderer can batch
+         * draws from bitmaps that share an atlas.  Call after loading bitmaps,
+         * from the thread that owns the display.
+         * 
+         * Bitmaps that do not preserve their data, such as render targets,
+         * bitmaps already packed and bitmaps that do not fit an atlas are skipped.
+         * 
+         * \tparam T Bitmap asset type.
+         * \param size Width and height of each atlas in pixels.
+         * \return Number of bitmaps packed.
+         */
+        template <typename T = al_bitmap>
+        inline static const std::size_t build_atlas(const int& size = 2048) {
+            auto& bitmaps = std::get<std::map<const std::string, wte_asset<T>>>(_assets);
+            //  Leave a pixel between regions so filtering does not bleed.
+            const int padding = 1;
+
+            std::vector<wte_asset<T>> packing;
+            for(auto& it: bitmaps) {
+                if(it.second->isconverted() || it.second->ispacked() || **it.second == NULL) continue;
+                if(it.second->get_width() + padding > size || it.second->get_height() + padding > size) continue;
+                //  The same bitmap may be loaded under more than one label.
+                if(std::find(packing.begin(), packing.end(), it.second) == packing.end())
+                    packing.push_back(it.second);
+            }
+
+            //  Pack tallest first into shelves.
+            std::stable_sort(packing.begin(), packing.end(),
+                [](const wte_asset<T>& a, const wte_asset<T>& b) {
+                    return a->get_height() > b->get_height();
+                });
+
+            std::size_t packed = 0;
+            wte_asset<T> atlas;
+            int shelf_x = 0, shelf_y = 0, shelf_h = 0;
+            for(auto& it: packing) {
+                const int w = it->get_width() + padding, h = it->get_height() + padding;
+                //  Start a new shelf, then a new atlas, when out of room.
+                if(atlas && shelf_x + w > size) {
+                    shelf_x = 0;
+                    shelf_y += shelf_h;
+                    shelf_h = 0;
+                }
+                if(!atlas || shelf_y + h > size) {
+                    atlas = make_asset(T(size, size));
+                    if(**atlas == NULL) break;
+                    atlases.push_back(atlas);
+                    shelf_x = shelf_y = shelf_h = 0;
+                }
+                if(it->pack(**atlas, shelf_x, shelf_y)) packed++;
+                shelf_x += w;
+                shelf_h = std::max(shelf_h, h);
+            }
+            return packed;
+        };
+
     private:
         assets() = default;
         ~assets() = default;
 
+        //  Atlas bitmaps created by build_atlas.
+        inline static std::vector<wte_asset<al_bitmap>> atlases;
+
         /*
          * The template specializations below generate a tuple of maps
          * for each asset type found in the game code.
@@ -12,17 +12,26 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <unordered_map>
 #include <algorithm>
 #include <stdexcept>
 #include <fstream>
+#include <atomic>
+#include <thread>
+#include <cstring>
 
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_physfs.h>
 
 #include "wtengine/mgr/manager.hpp"
 
+#include "wtengine/_debug/msg_trace.hpp"
+
 #include "wtengine/_globals/_defines.hpp"
 #include "wtengine/_globals/engine_time.hpp"
+#include "wtengine/_globals/intern.hpp"
+#include "wtengine/_globals/script_format.hpp"
 #include "wtengine/_globals/message.hpp"
 #include "wtengine/cmp/dispatcher.hpp"
 #include "wtengine/mgr/world.hpp"
@@ -35,7 +44,11 @@ namespace wte::mgr {
 
 /*!
  * \class messages
- * \brief Store a collection of message objects in a vector for processing.
+ * \brief Store a collection of message objects for processing.
+ * 
+ * Messages are routed to a queue for their system when added.
+ * Untimed messages are kept in arrival order.
+ * Timed messages are grouped by the tick they are due on.
  */
 class messages final : private manager<messages> {
     friend class wte::engine;
@@ -43,9 +56,15 @@ class messages final : private manager<messages> {
 
     public:
         /*!
-         * \brief Adds a message object to the start of the msg_queue vector.
+         * \brief Adds a message object to the queue.
          * 
-         * Then sorts if it's a timed event.
+         * The message is placed in the queue for its system.
+         * Timed events are placed in the bucket for their tick.
+         * 
+         * Safe to call from any thread.  Messages added from other threads
+         * are staged per thread and merged at the start of the next tick.
+         * Threads are merged in the order their staging buffers were
+         * registered, and each thread's messages in the order they were added.
          * 
          * \param msg Message to add.
          */
@@ -56,84 +75,116 @@ class messages final : private manager<messages> {
          * 
          * Can be called by a system message to load additional game data.
          * Note the timer value used for scripts is adjusted by the game timer.
+         * Indexed scripts are streamed in as game time reaches their messages.
          * 
          * \param fname Filename to load.
          * \return True if loaded, false if not.
          */
         static const bool load_script(const std::string& fname);
 
+        static const std::size_t& undelivered;  //!<  Entity messages with no recipient to deliver to.
+
     private:
-        inline messages() {
-            if constexpr (build_options.debug_mode) {
-                debug_log_file.open("wte_debug//messages.txt", std::ios::trunc);
-                debug_log_file << "Logging messages..." << std::endl << std::endl;
-            }
-        };
-        inline ~messages() { if constexpr (build_options.debug_mode) debug_log_file.close(); };
+        messages() = default;
+        ~messages() = default;
         //  Clear the message queue.
         static void clear(void);
         /*
          * Process dispatcher components. 
-         * Get messages for the entities and pass to each.
+         * Get messages for the entities and pass each to its recipient.
          * Keeps checking for responces and will process as well.
          */
         static void dispatch(void);
         /*
          * Load a new data file into the message queue.
          * This is called when a new game is created.
-         * Events are placed in order according to the timer value.
          */
         static void load_file(const std::string& fname);
         /*
-         * Get messages based on their command.
-         * Once events in the future are reached, break early.
+         * Load an opened data file, adding offset to timed messages.
+         * Indexed scripts are kept open and streamed, legacy files are read whole.
+         * Closes the file when done with it.
+         * Returns false if the file is an indexed script with a bad header.
+         */
+        static const bool load(ALLEGRO_FILE* file, const int64_t& offset);
+        //  Decode streamed script messages that are due.  Called by the engine each tick.
+        static void stream_scripts(void);
+        /*
+         * Get messages based on their system.
+         * Drains the system's untimed queue and its queue for this tick.
          */
-        static const message_container get(const std::string& sys);
-        //  Deletes timed messages that were not processed.
-        inline static void prune(void) {
-            for(auto it = _messages.begin(); it != _messages.end();) {
-                //  End early if events are in the future.
-                if(it->get_timer() > engine_time::check()) break;
-                if constexpr (build_options.debug_mode) {
-                    debug_log_file << "MESSAGE DELETED | ";
-                    log(*it);
-                }
-                it = _messages.erase(it);
-            }
+        static const message_container get(const intern_id& sys);
+        inline static const message_container get(const std::string& sys) {
+            return get(intern::id(sys));
         };
-        //  Read a message from file.
-        static void read(
-            ALLEGRO_FILE& file,
-            int64_t& timer,
-            std::string& sys,
-            std::string& to,
-            std::string& from,
-            std::string& cmd,
-            std::string& args
-        );
-        //  Write a message to the debug log file if debugging is enabled.
+        //  Deletes untimed and past timed messages that were not processed.
+        static void prune(void);
+        //  Move messages staged by other threads into the queues.
+        static void merge_staged(void);
+        //  Move the contents of a queue to the end of a message container.
+        static void drain(std::vector<message>& queue, message_container& to);
+        //  Route a message into its queue.  Main thread only.
+        static void route(const message& msg);
+        //  Read messages from a legacy data file.
+        static void read_legacy(ALLEGRO_FILE* file, const int64_t& offset);
+        //  Record a processed message to the trace if debugging is enabled.
         inline static void log(const message& msg) {
-            if constexpr (build_options.debug_mode) {
-                debug_log_file << "PROC AT:  " << engine_time::check() << " | ";
-                debug_log_file << "TIMER:  " << msg.get_timer() << " | ";
-                debug_log_file << "SYS:  " << msg.get_sys() << " | ";
-                if((msg.get_to() != "") || (msg.get_from() != "")) {
-                    debug_log_file << "TO:  " << msg.get_to() << " | ";
-                    debug_log_file << "FROM:  " << msg.get_from() << " | ";
-                }
-                debug_log_file << "CMD:  " << msg.get_cmd() << " | ";
-                debug_log_file << "ARGS:  ";
-                msg_args arglist = msg.get_args();
-                for(auto i = arglist.begin(); i != arglist.end(); i++) {
-                    debug_log_file << *i;
-                    if(std::next(i, 1) != arglist.end()) debug_log_file << ";";
-                }
-                debug_log_file << std::endl;
-            }
+            if constexpr (build_options.debug_mode) msg_trace::record(msg, trace::EVENT_PROCESSED);
         };
-        static std::ofstream debug_log_file;  //  For message logging
-        //  Vector of all messages to be processed
-        static message_container _messages;
+        static std::size_t _undelivered;      //  Undeliverable message count
+        //  Queues of messages by system.  Stored on the heap, they outlive the frame.
+        typedef std::unordered_map<intern_id, std::vector<message>> msg_queues;
+        //  Untimed messages, in the order they were added.
+        static msg_queues _untimed;
+        //  Timed messages, grouped by the tick they are due on.
+        static std::map<int64_t, msg_queues> _timed;
+
+        //  Message posted from another thread.
+        struct staged_msg {
+            staged_msg(const message& m) : msg(m), next(nullptr) {};
+            message msg;
+            staged_msg* next;
+        };
+        //  Per-thread list of staged messages, newest first.
+        struct staging_buffer {
+            std::atomic<staged_msg*> head{nullptr};
+            std::atomic<bool> in_use{true};              //  Owned by a running thread
+            std::atomic<staging_buffer*> next{nullptr};  //  Next buffer in registration order
+        };
+        //  Get the calling thread's buffer, claiming or registering one if needed.
+        static staging_buffer* get_staging_buffer(void);
+        //  Releases a thread's buffer for reuse when the thread exits.
+        struct staging_owner {
+            staging_buffer* buffer = nullptr;
+            ~staging_owner() { if(buffer) buffer->in_use.store(false, std::memory_order_release); };
+        };
+        static thread_local staging_owner staging;         //  This thread's buffer
+        static std::atomic<staging_buffer*> staging_list;  //  All registered buffers
+        static const std::thread::id main_thread;          //  Thread that owns the queues
+
+        //  Indexed script being streamed into the queue.
+        struct script_stream {
+            ALLEGRO_FILE* file;                   //  Open script file
+            int64_t offset;                       //  Added to timed messages
+            script::header header;                //  File header
+            std::vector<std::string> strings;     //  String table
+            std::vector<intern_id> ids;           //  Interned strings, filled as used
+            std::vector<script::record> records;  //  Current batch of records
+            std::vector<script::value> values;    //  Payload for the current batch
+            std::size_t batch_pos;                //  Next record in the batch
+            uint32_t next_record;                 //  Next record to read from file
+        };
+        //  Number of records read from a script at a time.
+        inline static constexpr uint32_t STREAM_BATCH = 256;
+        //  Read the next batch of records.  Returns false at the end of the script.
+        static const bool read_batch(script_stream& s);
+        static std::vector<script_stream> streams;  //  Scripts being streamed
+
+        //  IDs of the systems the engine drains each frame.
+        inline static const intern_id SYS_ENTITIES = intern::id("entities");
+        inline static const intern_id SYS_SYSTEM = intern::id("system");
+        inline static const intern_id SYS_AUDIO = intern::id("audio");
+        inline static const intern_id SYS_SPAWNER = intern::id("spawner");
 };
 
 }  //  end namespace wte::mgr
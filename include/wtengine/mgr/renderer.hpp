@@ -13,15 +13,24 @@
 #include <string>
 #include <utility>
 #include <set>
+#include <unordered_set>
+#include <vector>
 #include <iterator>
+#include <algorithm>
 #include <memory>
 #include <chrono>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <stdexcept>
 #include <cassert>
 
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_image.h>
 #include <allegro5/allegro_font.h>
+#include <allegro5/allegro_primitives.h>
 
 #include "wtengine/mgr/manager.hpp"
 
@@ -46,6 +55,10 @@ namespace wte {
     typedef std::chrono::system_clock::duration duration;
 }
 
+namespace wte::mgr {
+    class systems;
+}
+
 namespace wte::mgr::gfx {
 
 /*!
@@ -62,6 +75,7 @@ using entity_component_pair = std::pair<const entity_id, std::shared_ptr<const T
 class renderer final : private manager<renderer> {
     friend class wte::display;
     friend class wte::engine;
+    friend class wte::mgr::systems;
 
     public:
         /*!
@@ -78,6 +92,70 @@ class renderer final : private manager<renderer> {
             const int& h
         );
 
+        /*!
+         * \brief Add a viewport.
+         * 
+         * Each viewport draws the world through its own camera to an area of the arena.
+         * Viewport 0 always exists and covers the whole arena until resized.
+         * 
+         * \param x X position in the arena.
+         * \param y Y position in the arena.
+         * \param w Width in pixels.
+         * \param h Height in pixels.
+         * \return Index of the new viewport.
+         */
+        static const std::size_t add_viewport(
+            const float& x,
+            const float& y,
+            const float& w,
+            const float& h
+        );
+
+        /*!
+         * \brief Move and resize a viewport.
+         * 
+         * \param vp Index of the viewport.
+         * \param x X position in the arena.
+         * \param y Y position in the arena.
+         * \param w Width in pixels.
+         * \param h Height in pixels.
+         * \exception Viewport does not exist.
+         */
+        static void set_viewport(
+            const std::size_t& vp,
+            const float& x,
+            const float& y,
+            const float& w,
+            const float& h
+        );
+
+        /*!
+         * \brief Position a viewport's camera.
+         * 
+         * The camera's position is the world location drawn at the top left of the viewport.
+         * Sprites and hitboxes are drawn through the camera.  Backgrounds and overlays
+         * are drawn in arena coordinates.
+         * 
+         * \param x World X position.
+         * \param y World Y position.
+         * \param zoom Zoom factor, 1 for none.
+         * \param vp Index of the viewport, defaults to 0.
+         * \exception Viewport does not exist.
+         */
+        static void set_camera(
+            const float& x,
+            const float& y,
+            const float& zoom = 1.0f,
+            const std::size_t& vp = 0
+        );
+
+        /*!
+         * \brief Remove all viewports but a single one covering the arena, with its camera reset.
+         * 
+         * Called by the engine when a new game starts.
+         */
+        static void clear_viewports(void);
+
         /*!
          * \brief Set the title screen.
          * 
@@ -98,10 +176,22 @@ class renderer final : private manager<renderer> {
          */
         static void set_font(wte_asset<al_font> font);
 
+        /*!
+         * \brief Check if the calling thread may create or draw to bitmaps.
+         * 
+         * Always true unless the render thread is running.
+         * Then only true for the thread holding the display.
+         * 
+         * \return True if bitmaps can be used.
+         */
+        static const bool holding_display(void);
+
         static const std::size_t& fps;                       //!<  Frames per second
         static const time_point<system_clock>& last_render;  //!<  Point in time last render completed
         static const time_point<system_clock>& start_time;   //!<  Point in time the renderer started
         static const duration& delta_time;                   //!<  Time between frame renders
+        static const std::size_t& drawn;                     //!<  Bitmaps drawn in the arena last frame
+        static const std::size_t& culled;                    //!<  Bitmaps skipped last frame for being out of view
 
     private:
         renderer() = default;
@@ -114,55 +204,302 @@ class renderer final : private manager<renderer> {
         //  Draw the game screen.
         static void render(void);
 
-        //  For sorting.
-        template <typename T> struct comparator {
-            const bool operator() (const T& a, const T& b) const {
-                return *a.second < *b.second;
+        //  A component in a persistent render list.
+        template <typename T>
+        struct render_item {
+            entity_id e_id;                 //  Entity the component belongs to.
+            std::shared_ptr<const T> comp;  //  The component.
+            std::size_t layer;              //  Layer when last sorted.
+            ALLEGRO_BITMAP* texture;        //  Texture when last sorted, sprites only.
+        };
+
+        //  An area of the arena and the camera drawn to it.
+        struct viewport {
+            float x, y, w, h;         //  Area of the arena.
+            float cam_x, cam_y, zoom;  //  Camera position and zoom.
+        };
+
+        //  Components to draw, kept between frames.
+        template <typename T>
+        using render_list = std::vector<render_item<T>>;
+
+        //  Get the texture a bitmap is stored in.
+        inline static ALLEGRO_BITMAP* texture_of(ALLEGRO_BITMAP* bmp) {
+            ALLEGRO_BITMAP* parent = al_get_parent_bitmap(bmp);
+            return (parent == NULL ? bmp : parent);
+        };
+
+        //  Add a component to a render list.
+        template <typename T>
+        inline static void add_item(
+            render_list<T>& list, const entity_id& e_id,
+            const std::shared_ptr<const T>& comp, const bool& by_texture
+        ) {
+            list.push_back({ e_id, comp, comp->layer,
+                (by_texture ? texture_of(**comp->_bitmap) : NULL) });
+        };
+
+        //  Fill a render list from the world.
+        template <typename T>
+        inline static void rebuild_list(render_list<T>& list, const bool& by_texture) {
+            list.clear();
+            const const_component_container<T> components = mgr::world::get_components<T>();
+            for(auto& it: components) add_item(list, it.first, it.second, by_texture);
+        };
+
+        /*
+         * Check a render list for layer and texture changes, and sort it if anything changed.
+         * Lists are sorted by layer, then texture, then entity.
+         */
+        template <typename T>
+        inline static void refresh_list(render_list<T>& list, bool changed, const bool& by_texture) {
+            for(auto& it: list) {
+                if(it.layer != it.comp->layer) {
+                    it.layer = it.comp->layer;
+                    changed = true;
+                }
+                if(by_texture) {
+                    ALLEGRO_BITMAP* texture = texture_of(**it.comp->_bitmap);
+                    if(it.texture != texture) {
+                        it.texture = texture;
+                        changed = true;
+                    }
+                }
             }
+            if(!changed) return;
+            std::sort(list.begin(), list.end(), [](const render_item<T>& a, const render_item<T>& b) {
+                if(a.layer != b.layer) return a.layer < b.layer;
+                if(a.texture != b.texture) return std::less<ALLEGRO_BITMAP*>()(a.texture, b.texture);
+                return a.e_id < b.e_id;
+            });
         };
 
-        //  Draw hitboxes if debug mode is enabled.
-        inline static void draw_hitboxes(void) {
-            if constexpr (build_options.debug_mode) {
-                const const_component_container<cmp::hitbox> hitbox_components =
-                    mgr::world::get_components<cmp::hitbox>();
-
-                for(auto& it: hitbox_components) {
-                    if(it.second->solid) {
-                        //  Select color based on team.
-                        ALLEGRO_COLOR team_color;
-                        switch(it.second->team) {
-                            case 0: team_color = WTE_COLOR_GREEN; break;
-                            case 1: team_color = WTE_COLOR_RED; break;
-                            case 2: team_color = WTE_COLOR_BLUE; break;
-                            default: team_color = WTE_COLOR_YELLOW;
-                        }
-                        //  Draw the hitbox.
-                        ALLEGRO_BITMAP* temp_bitmap = al_create_bitmap(
-                            it.second->width,
-                            it.second->height);
-                        al_set_target_bitmap(temp_bitmap);
-                        al_clear_to_color(team_color);
-                        al_set_target_bitmap(**arena_bitmap);
-                        try {
-                            al_draw_bitmap(temp_bitmap,
-                                mgr::world::get_component<cmp::location>(it.first)->pos_x,
-                                mgr::world::get_component<cmp::location>(it.first)->pos_y, 0);
-                        } catch(const exception& e) { throw e; }
-                        al_destroy_bitmap(temp_bitmap);
+        //  Remove the components in the removed set from a render list.
+        template <typename T>
+        inline static void remove_items(render_list<T>& list) {
+            list.erase(std::remove_if(list.begin(), list.end(), [](const render_item<T>& it) {
+                return removed.count(static_cast<const cmp::component*>(it.comp.get())) > 0;
+            }), list.end());
+        };
+
+        //  Apply world changes to the render lists and keep them sorted.
+        static void update_lists(void);
+
+        //  A single bitmap draw, queued so draws can be sorted and batched.
+        struct draw_item {
+            std::size_t layer;         //  Layer to draw on.
+            ALLEGRO_BITMAP* bitmap;    //  Bitmap to draw from.
+            ALLEGRO_BITMAP* source;    //  Component bitmap, the same unless a copy is drawn.
+            ALLEGRO_BITMAP* texture;   //  Texture the bitmap is stored in, for sorting.
+            float sx, sy, sw, sh;      //  Source region.
+            ALLEGRO_COLOR tint;        //  Tint color, white for none.
+            float cx, cy, dx, dy;      //  Center and destination.
+            float xscale, yscale;      //  Scale factors.
+            float angle;               //  Rotation angle.
+        };
+
+        //  List of draws, kept with its snapshot so the memory is reused.
+        typedef std::vector<draw_item> draw_list;
+
+        //  Sprites seen through a viewport.
+        struct viewport_draws {
+            viewport vp;        //  Viewport and camera.
+            draw_list sprites;  //  Sprite draws, in layer and texture order.
+        };
+
+        //  A copy of a component bitmap, so the component can draw to it before the copy is drawn.
+        struct bitmap_copy {
+            wte_asset<al_bitmap> source;  //  Bitmap copied.  Held so its address is not reused.
+            std::size_t revision;         //  Revision of the component when copied.
+            ALLEGRO_BITMAP* bitmap;       //  The copy.
+        };
+
+        //  Everything needed to draw a frame, so drawing does not read the world.
+        struct snapshot {
+            bool game_started;                  //  Draw the arena, or the title screen.
+            draw_list backgrounds;              //  Background draws, in layer order.
+            std::vector<std::size_t> background_revisions;  //  Bitmap revision of each background draw.
+            std::vector<viewport_draws> views;  //  Sprite draws for each viewport.
+            draw_list overlays;                 //  Overlay draws, in layer order.
+            std::vector<ALLEGRO_VERTEX> hitboxes;  //  Hitbox triangles, if shown.
+            bool draw_fps;                      //  Show the frame rate.
+            std::size_t fps;                    //  Frame rate to show.
+            int64_t timer;                      //  Engine time to show in debug mode.
+            std::vector<bitmap_copy> copies;    //  Copies of bitmaps drawn to, owned by the snapshot.
+            std::size_t copies_used;            //  Copies used by this snapshot.
+        };
+
+        //  Record what to draw from the world.  Main thread only, with the display held.
+        static void take_snapshot(snapshot& snap);
+
+        /*
+         * Get the bitmap for a snapshot to draw.  With the render thread, bitmaps that
+         * have been drawn to are copied, since they may change again before the snapshot
+         * is drawn.  Copies are only redrawn when the component's revision changes.
+         */
+        static ALLEGRO_BITMAP* snapshot_bitmap(
+            snapshot& snap, const wte_asset<al_bitmap>& bmp, const std::size_t& revision);
+
+        //  Let go of the sources of copies not used by the last snapshot taken.
+        static void release_copies(snapshot& snap);
+        //  Draw a snapshot to the screen and flip the display.
+        static void draw_frame(const snapshot& snap);
+
+        /*
+         * Draw a range of a list with bitmap drawing held, so consecutive draws
+         * from the same texture are batched.  Draws in list order.
+         */
+        static void draw(draw_list::const_iterator first, draw_list::const_iterator last);
+
+        //  Draw a whole list.
+        inline static void draw(const draw_list& items) { draw(items.begin(), items.end()); };
+
+        //  Backgrounds composited into an arena sized bitmap.
+        struct layer_cache {
+            ALLEGRO_BITMAP* bitmap;                //  The composite.
+            draw_list items;                       //  Draws it was made from.
+            std::vector<std::size_t> revisions;    //  Bitmap revisions it was made from.
+        };
+
+        //  Check if two draws are the same.
+        inline static const bool same_draw(const draw_item& a, const draw_item& b) {
+            return a.layer == b.layer && a.source == b.source &&
+                a.sx == b.sx && a.sy == b.sy && a.sw == b.sw && a.sh == b.sh &&
+                a.tint.r == b.tint.r && a.tint.g == b.tint.g &&
+                a.tint.b == b.tint.b && a.tint.a == b.tint.a &&
+                a.cx == b.cx && a.cy == b.cy && a.dx == b.dx && a.dy == b.dy &&
+                a.xscale == b.xscale && a.yscale == b.yscale && a.angle == b.angle;
+        };
+
+        /*
+         * Draw the backgrounds.  Runs of backgrounds unchanged since the last frame
+         * are composited into a cached layer, redrawn only when one of them changes.
+         */
+        static void draw_backgrounds(const snapshot& snap);
+
+        /*
+         * Check if a draw overlaps the view, counting it as drawn or culled.
+         * Takes the unrotated top left corner and scaled size.  Rotated draws
+         * are tested by the square around their rotation.
+         */
+        inline static const bool in_view(
+            const float& x, const float& y, float w, float h, const bool& rotated
+        ) {
+            float min_x = x, min_y = y;
+            //  Negative scales flip the draw back over its origin.
+            if(w < 0) { min_x += w;  w = -w; }
+            if(h < 0) { min_y += h;  h = -h; }
+            if(rotated) {
+                const float r = std::hypot(w, h) / 2;
+                min_x += (w / 2) - r;
+                min_y += (h / 2) - r;
+                w = h = r * 2;
+            }
+            if(
+                min_x < view_x + view_w && min_x + w > view_x &&
+                min_y < view_y + view_h && min_y + h > view_y
+            ) {
+                _drawn++;
+                return true;
+            }
+            _culled++;
+            return false;
+        };
+
+        //  Queue a background or overlay if it is in view.
+        template <typename T>
+        inline static void queue_bitmap(
+            snapshot& snap, draw_list& list, const std::shared_ptr<const T>& comp
+        ) {
+            draw_item item;
+            item.layer = comp->layer;
+            item.bitmap = **comp->_bitmap;
+            item.source = item.bitmap;
+            item.texture = item.bitmap;
+            item.sx = 0.0f;
+            item.sy = 0.0f;
+            item.sw = al_get_bitmap_width(item.bitmap);
+            item.sh = al_get_bitmap_height(item.bitmap);
+            item.tint = (comp->tinted ? comp->get_tint() : al_map_rgba_f(1.0f, 1.0f, 1.0f, 1.0f));
+            item.xscale = comp->scale_factor_x;
+            item.yscale = comp->scale_factor_y;
+
+            if(comp->rotated) {
+                item.angle = comp->direction;
+                item.cx = (al_get_bitmap_width(item.bitmap) / 2);
+                item.cy = (al_get_bitmap_height(item.bitmap) / 2);
+                item.dx = comp->pos_x + (item.sw * comp->scale_factor_x / 2);
+                item.dy = comp->pos_y + (item.sh * comp->scale_factor_y / 2);
+            } else {
+                item.angle = 0.0f;
+                item.cx = 0.0f;
+                item.cy = 0.0f;
+                item.dx = comp->pos_x;
+                item.dy = comp->pos_y;
+            }
+
+            if(in_view(comp->pos_x, comp->pos_y,
+                item.sw * item.xscale, item.sh * item.yscale, comp->rotated)) {
+                item.bitmap = snapshot_bitmap(snap, comp->_bitmap, comp->revision);
+                list.push_back(item);
+            }
+        };
+
+        //  Record the solid hitboxes as triangles, two per hitbox.
+        inline static void take_hitboxes(std::vector<ALLEGRO_VERTEX>& hitboxes) {
+            const const_component_container<cmp::hitbox> hitbox_components =
+                mgr::world::get_components<cmp::hitbox>();
+
+            hitboxes.reserve(hitbox_components.size() * 6);
+            for(auto& it: hitbox_components) {
+                if(it.second->solid) {
+                    //  Select color based on team.
+                    ALLEGRO_COLOR team_color;
+                    switch(it.second->team) {
+                        case 0: team_color = WTE_COLOR_GREEN; break;
+                        case 1: team_color = WTE_COLOR_RED; break;
+                        case 2: team_color = WTE_COLOR_BLUE; break;
+                        default: team_color = WTE_COLOR_YELLOW;
                     }
+                    float x1, y1;
+                    try {
+                        cmp::const_comp_ptr<cmp::location> loc = mgr::world::get_component<cmp::location>(it.first);
+                        x1 = loc->pos_x;
+                        y1 = loc->pos_y;
+                    } catch(const exception& e) { throw e; }
+                    const float x2 = x1 + it.second->width;
+                    const float y2 = y1 + it.second->height;
+
+                    hitboxes.push_back({ x1, y1, 0.0f, 0.0f, 0.0f, team_color });
+                    hitboxes.push_back({ x2, y1, 0.0f, 0.0f, 0.0f, team_color });
+                    hitboxes.push_back({ x2, y2, 0.0f, 0.0f, 0.0f, team_color });
+                    hitboxes.push_back({ x1, y1, 0.0f, 0.0f, 0.0f, team_color });
+                    hitboxes.push_back({ x2, y2, 0.0f, 0.0f, 0.0f, team_color });
+                    hitboxes.push_back({ x1, y2, 0.0f, 0.0f, 0.0f, team_color });
                 }
             }
         };
 
-        //  Draw time if debug mode is enabled.
-        inline static void draw_timer(void) {
+        //  Draw hitboxes in a single call if debug mode is enabled.
+        inline static void draw_hitboxes(const std::vector<ALLEGRO_VERTEX>& hitboxes) {
             if constexpr (build_options.debug_mode) {
-                const std::string timer_string = "Timer: " + std::to_string(engine_time::check());
-                al_draw_text(**renderer_font, WTE_COLOR_YELLOW, config::gfx::screen_w, 10, ALLEGRO_ALIGN_RIGHT, timer_string.c_str());
+                if(hitboxes.empty()) return;
+                al_draw_prim(hitboxes.data(), NULL, NULL, 0,
+                    static_cast<int>(hitboxes.size()), ALLEGRO_PRIM_TRIANGLE_LIST);
             }
         };
 
+        //  Start drawing on the render thread, if built with it.
+        static void start_thread(void);
+        //  Stop the render thread and take the display back.
+        static void stop_thread(void);
+        //  Render thread loop.
+        static void run(void);
+        //  Take the display for the main thread, to draw to or create and destroy bitmaps.
+        static void hold_display(void);
+        //  Let the render thread use the display.
+        static void release_display(void);
+
         static ALLEGRO_TIMER* fps_timer;
         static ALLEGRO_EVENT_QUEUE* fps_event_queue;
         static ALLEGRO_EVENT fps_event;
@@ -177,6 +514,34 @@ class renderer final : private manager<renderer> {
 
         static bool arena_created;
 
+        static std::vector<viewport> viewports;
+        static float view_x, view_y, view_w, view_h;  //  Area of the world being drawn.
+        static std::size_t _drawn, _culled;
+
+        //  Render lists, updated from world changes.
+        static render_list<cmp::gfx::background> backgrounds;
+        static render_list<cmp::gfx::sprite> sprites;
+        static render_list<cmp::gfx::overlay> overlays;
+        static std::vector<component_change> changes;    //  World changes being applied.
+        static std::unordered_set<const cmp::component*> removed;  //  Components removed this frame.
+
+        //  Background caching, used by the thread drawing.
+        static std::vector<layer_cache> layer_caches;
+        static draw_list last_backgrounds;
+        static std::vector<std::size_t> last_revisions;
+
+        //  Snapshots being built, waiting to be drawn and being drawn.
+        static snapshot snapshots[3];
+        static std::size_t back, ready, front;
+        static bool fresh;                            //  Waiting snapshot not drawn yet.
+        static std::atomic<bool> thread_running;
+        static std::thread render_thread;
+        static std::mutex snapshot_mtx;               //  Guards ready and fresh.
+        static std::mutex display_mtx;                //  Held by the thread using the display.
+        static std::atomic<std::thread::id> display_owner;  //  Main loop thread while it holds the display.
+        static std::condition_variable snapshot_cv;
+        static ALLEGRO_DISPLAY* render_display;
+
         static std::string title_screen_file;
         static std::string background_file;
 };
@@ -11,27 +11,131 @@
 #define WTE_MGR_SPAWNER_HPP
 
 #include <string>
+#include <vector>
 #include <utility>
 #include <map>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
 #include <functional>
 
 #include "wtengine/mgr/manager.hpp"
 
+#include "wtengine/_globals/intern.hpp"
 #include "wtengine/_globals/message.hpp"
+#include "wtengine/cmp/component.hpp"
 #include "wtengine/mgr/world.hpp"
 
 namespace wte {
     class engine;
+    namespace mgr {
+        class spawner;
+    }
 }
 
+namespace wte {
+
+/*!
+ * \class prefab
+ * \brief A template for spawning entities.
+ * 
+ * Stores how to build each component, so any number of entities
+ * can be made from it without a spawn function adding them one by one.
+ * 
+ * A prefab can be pooled.  Deleting a pooled entity deactivates it instead,
+ * and later spawns reuse it with its components rebuilt in place.
+ * Entities removed with mgr::world::delete_entity leave the pool.
+ */
+class prefab final {
+    friend class mgr::spawner;
+
+    public:
+        prefab() = default;   //!<  Default constructor.
+        ~prefab() = default;  //!<  Default destructor.
+
+        /*!
+         * \brief Add a component to the prefab.
+         * 
+         * Each spawned entity gets a new component built from a copy of the arguments.
+         * Components must be move assignable, so pooled entities can be reset.
+         * A reset moves a newly built component into place, so functions stored
+         * in a component must not capture the component itself.
+         * 
+         * \tparam T Component type to add.
+         * \param args List of parameters to pass to component constructor.
+         * \return Reference to this prefab.
+         */
+        template <typename T, typename... Args>
+        inline prefab& add(Args... args) {
+            static_assert(std::is_move_assignable_v<T>, "Prefab components must be move assignable.");
+            factories.push_back([args...]() -> cmp::component_sptr {
+                return std::make_shared<T>(args...);
+            });
+            //  Reset a pooled component in its existing storage.
+            resetters.push_back([args...](cmp::component* comp) {
+                T* old_comp = static_cast<T*>(comp);
+                *old_comp = T(args...);
+            });
+            return *this;
+        };
+
+        /*!
+         * \brief Keep deleted entities of this prefab for reuse.
+         * 
+         * Components added to an entity after it was spawned are kept with it.
+         * 
+         * \param size Most inactive entities to keep.  0 to disable pooling.
+         * \return Reference to this prefab.
+         */
+        inline prefab& pooled(const std::size_t& size) {
+            pool_size = size;
+            return *this;
+        };
+
+        /*!
+         * \brief Set a function to run on each entity after it is spawned.
+         * 
+         * Passed the entity, the spawn message and the entity's position in its batch.
+         * Use the position to read per entity values from the message's payload.
+         * 
+         * \param func Function to run.
+         * \return Reference to this prefab.
+         */
+        inline prefab& on_spawn(
+            const std::function<void(const entity_id&, const message&, const std::size_t&)>& func
+        ) {
+            init = func;
+            return *this;
+        };
+
+    private:
+        //  Functions to build each component.
+        std::vector<std::function<cmp::component_sptr(void)>> factories;
+        //  Functions to reset each component, in the same order.
+        std::vector<std::function<void(cmp::component*)>> resetters;
+        //  Number of inactive entities to keep.
+        std::size_t pool_size = 0;
+        //  Per entity setup.
+        std::function<void(const entity_id&, const message&, const std::size_t&)> init;
+};
+
+}  //  end namespace wte
+
 namespace wte::mgr {
 
 /*!
  * \class spawner
  * \brief Create or delete entities while the engine is running.
+ * 
+ * Spawner commands:
+ *   new;name;args...         - Create one entity from a spawn or prefab.
+ *   batch;name;count;args... - Create count entities from a prefab at once.
+ *   delete;name              - Delete an entity by name.
+ *                              Entities from a pooled prefab are deactivated for reuse.
  */
 class spawner final : private manager<spawner> {
     friend class wte::engine;
+    friend class world;
 
     public:
         /*!
@@ -51,7 +155,39 @@ class spawner final : private manager<spawner> {
         );
 
         /*!
-         * \brief Delete a spawn.
+         * \brief Add a spawn that reads the whole spawn message.
+         * 
+         * Use to access the message's typed payload.
+         * 
+         * \param name Reference name for the spwaner item.
+         * \param num_args Number of arguments the spawn accepts.
+         * \param func Function for creating the entity.
+         * \return True if inserted into the spawn map, false if not.
+         */
+        static const bool add(
+            const std::string& name,
+            const std::size_t& num_args,
+            const std::function<void(const entity_id&, const message&)>& func
+        );
+
+        /*!
+         * \brief Add a prefab to the spawner.
+         * 
+         * Prefabs can be spawned with the new or batch commands.
+         * 
+         * \param name Reference name for the prefab.
+         * \param num_args Number of arguments the prefab accepts.
+         * \param pre Prefab to spawn from.
+         * \return True if inserted, false if a spawn or prefab with the name exists.
+         */
+        static const bool add(
+            const std::string& name,
+            const std::size_t& num_args,
+            const prefab& pre
+        );
+
+        /*!
+         * \brief Delete a spawn or prefab.
          * \param name Name of spawn to delete.
          */
         static const bool remove(const std::string& name);
@@ -62,13 +198,39 @@ class spawner final : private manager<spawner> {
 
         //  Takes spawner messages and processes.
         static void process_messages(const message_container& messages);
+        //  Clear the entity pools.
+        static void clear(void);
+        //  Create count entities from a prefab, reusing pooled entities first.
+        static void spawn_prefab(
+            const std::string& name, const prefab& pre,
+            const std::size_t& count, const message& msg);
+        //  Delete an entity, or return it to its pool.
+        static void despawn(const entity_id& e_id);
+        //  Stop tracking an entity deleted from the world.
+        static void forget(const entity_id& e_id);
 
         static std::map<
             const std::string,
             std::pair<
                 const std::size_t,
-                const std::function<void(const entity_id&, const msg_args&)>
+                const std::function<void(const entity_id&, const message&)>
         >> spawns;
+
+        static std::map<const std::string, std::pair<const std::size_t, const prefab>> prefabs;
+
+        //  A spawned entity from a pooled prefab.
+        struct pool_item {
+            std::string prefab;                      //  Prefab it was made from.
+            std::vector<cmp::component_sptr> comps;  //  Prefab components, in prefab order.
+        };
+        //  Entities from pooled prefabs, both active and inactive.
+        static std::unordered_map<entity_id, pool_item> pool_items;
+        //  Inactive entities ready for reuse, by prefab.
+        static std::map<const std::string, std::vector<entity_id>> pools;
+
+        inline static const intern_id CMD_NEW = intern::id("new");
+        inline static const intern_id CMD_BATCH = intern::id("batch");
+        inline static const intern_id CMD_DELETE = intern::id("delete");
 };
 
 }  //  end namespace wte::mgr
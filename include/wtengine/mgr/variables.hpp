@@ -158,6 +158,7 @@ class variables final : private manager<variables> {
         ) {
             verify<T>();
             auto ret = _map.insert(std::make_pair(var, std::make_any<T>(val)));
+            if(ret.second) _revisions[var] = ++last_revision;
             return ret.second;
         };
 
@@ -189,12 +190,24 @@ class variables final : private manager<variables> {
             verify<T>();
             try {
                 _map.at(var) = std::make_any<T>(val);
+                _revisions[var] = ++last_revision;
             } catch(std::out_of_range& e) {
                 std::string err_msg = "Could not set variable: " + var;
                 throw exception(exception_item(err_msg.c_str(), "variables", engine_time::check()));
             }
         };
 
+        /*!
+         * \brief Get a variable's revision.
+         * 
+         * The revision changes each time the variable is set.
+         * Used to check if a variable changed without reading it.
+         * 
+         * \param var Variable name.
+         * \return The variable's revision, zero if not registered.
+         */
+        static const std::size_t revision(const std::string& var);
+
         /*!
          * \brief Get a variable's value.
          * \tparam T Variable type.
@@ -245,6 +258,8 @@ class variables final : private manager<variables> {
 
         static std::string data_file_name;  //  File to save variables to.
         static std::map<const std::string, std::any> _map;  //  Map of variables.
+        static std::map<const std::string, std::size_t> _revisions;  //  Revision of each variable.
+        static std::size_t last_revision;  //  Last revision given out.
 };
 
 }  //  end namespace wte::mgr
@@ -15,6 +15,7 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <iterator>
 #include <algorithm>
@@ -25,6 +26,8 @@
 #include "wtengine/mgr/manager.hpp"
 
 #include "wtengine/_debug/exceptions.hpp"
+#include "wtengine/_globals/_defines.hpp"
+#include "wtengine/_globals/frame_arena.hpp"
 #include "wtengine/_globals/engine_time.hpp"
 #include "wtengine/cmp/component.hpp"
 
@@ -64,23 +67,43 @@ namespace wte {
 
     /*!
     * Container for storing components of similar type.
+    * Allocated from the frame arena, only valid until the end of the frame.
     * \tparam Component type
     */
     template <typename T>
-    using component_container = std::map<const entity_id, std::shared_ptr<T>>;
+    using component_container = std::map<
+        const entity_id, std::shared_ptr<T>, std::less<const entity_id>,
+        frame_allocator<std::pair<const entity_id, std::shared_ptr<T>>>>;
 
     /*!
     * Constant container for storing components of similar type.
+    * Allocated from the frame arena, only valid until the end of the frame.
     * \tparam Component type
     */
     template <typename T>
-    using const_component_container = std::map<const entity_id, std::shared_ptr<const T>>;
+    using const_component_container = std::map<
+        const entity_id, std::shared_ptr<const T>, std::less<const entity_id>,
+        frame_allocator<std::pair<const entity_id, std::shared_ptr<const T>>>>;
 
     /*!
     * \typedef std::unordered_multimap<entity_id, cmp::component_sptr> world_map
     * Container to store the entire game world.
     */
     typedef std::unordered_multimap<entity_id, cmp::component_sptr> world_map;
+
+    /*!
+    * \struct component_change
+    * A component added to or removed from the world.
+    */
+    struct component_change {
+        entity_id e_id;             //!<  Entity the component belongs to.
+        cmp::component_csptr comp;  //!<  The component.
+        bool added;                 //!<  True if added, false if removed.
+    };
+}
+
+namespace wte::mgr::gfx {
+    class renderer;
 }
 
 namespace wte::mgr {
@@ -91,6 +114,7 @@ namespace wte::mgr {
  */
 class world final : private manager<world> {
     friend class wte::engine;
+    friend class gfx::renderer;
 
     public:
         /*!
@@ -99,13 +123,50 @@ class world final : private manager<world> {
          */
         static const entity_id new_entity(void);
 
+        /*!
+         * \brief Create a group of new entities at once.
+         * 
+         * The entity list is locked once for the whole group.
+         * 
+         * \param count Number of entities to create.
+         * \return The new entity IDs.  Stops early if IDs run out.
+         */
+        static const std::vector<entity_id> new_entities(const std::size_t& count);
+
         /*!
          * \brief Delete entity by ID.
+         * 
+         * Inactive entities can also be deleted.
+         * Entities from a pooled prefab are removed from their pool.
+         * 
          * \param e_id The entity ID to delete.
          * \return Return true on success, false if entity does not exist.
          */
         static const bool delete_entity(const entity_id& e_id);
 
+        /*!
+         * \brief Deactivate an entity, keeping it and its components for reuse.
+         * 
+         * Inactive entities are hidden from the world.  They are not found by ID
+         * or name, are not listed with the entities and their components are not
+         * returned by any component query.  Components keep their memory until
+         * the entity is reactivated or the world is cleared.
+         * 
+         * \param e_id The entity ID to deactivate.
+         * \return True on success, false if the entity does not exist.
+         */
+        static const bool deactivate_entity(const entity_id& e_id);
+
+        /*!
+         * \brief Reactivate an inactive entity with its components.
+         * 
+         * The entity gets back its name, or a new one if the name has since been taken.
+         * 
+         * \param e_id The entity ID to reactivate.
+         * \return True on success, false if the entity is not inactive.
+         */
+        static const bool activate_entity(const entity_id& e_id);
+
         /*!
          * \brief Check if an entity exists by ID.
          * \param e_id The entity ID to check.
@@ -141,6 +202,9 @@ class world final : private manager<world> {
 
         /*!
          * \brief Get the entity reference vector.
+         * 
+         * Deleting an entity moves the last one into its place, so the order is not kept.
+         * 
          * \return Returns a vector of all entity IDs and names.
          */
         static const entities get_entities(void);
@@ -184,11 +248,26 @@ class world final : private manager<world> {
             }
 
             world_mtx.lock();
-            _world.insert(std::make_pair(e_id, std::make_shared<T>(args...)));
+            const auto w_it = _world.insert(std::make_pair(e_id, std::make_shared<T>(args...)));
+            log_change(e_id, w_it->second, true);
             world_mtx.unlock();
+            wake_entity(e_id);
             return true;
         };
 
+        /*!
+         * \brief Add a group of built components to entities in one step.
+         * 
+         * The world is locked once for the whole group.
+         * Use with new_entities to build many entities at once.
+         * 
+         * \param comps Pairs of entity IDs and the component to add to each.
+         * \return Number of components added.  Components are skipped if the
+         * entity does not exist or already has a component of the same type.
+         */
+        static const std::size_t add_components(
+            const std::vector<std::pair<entity_id, cmp::component_sptr>>& comps);
+
         /*!
          * \brief Delete a component by type for an entity.
          * \tparam T Component type to delete.
@@ -205,8 +284,10 @@ class world final : private manager<world> {
             for(auto it = results.first; it != results.second; it++) {
                 if(std::dynamic_pointer_cast<T>(it->second)) {
                     world_mtx.lock();
+                    log_change(e_id, it->second, false);
                     it = _world.erase(it);
                     world_mtx.unlock();
+                    wake_entity(e_id);
                     return true;
                 }
             }
@@ -234,6 +315,9 @@ class world final : private manager<world> {
 
         /*!
          * \brief Set the value of a component by type for an entity.
+         * 
+         * Wakes the entity if it is sleeping.
+         * 
          * \tparam T Component type to search.
          * \param e_id The entity ID to search.
          * \return Return the component.
@@ -245,8 +329,11 @@ class world final : private manager<world> {
             const auto results = _world.equal_range(e_id);
 
             for(auto it = results.first; it != results.second; it++) {
-                if(std::dynamic_pointer_cast<T>(it->second))
+                if(std::dynamic_pointer_cast<T>(it->second)) {
+                    world_mtx.unlock();
+                    wake_entity(e_id);
                     return std::static_pointer_cast<T>(it->second);
+                }
             }
             world_mtx.unlock();
 
@@ -254,6 +341,29 @@ class world final : private manager<world> {
                 exception_item("Entity: " + std::to_string(e_id) + " - Component not found", "World", 4));
         };
 
+        /*!
+         * \brief Set the value of a component by type without waking the entity.
+         * 
+         * For systems that write to many components at once.
+         * Wake the changed entities afterwards with wake_entities.
+         * 
+         * \tparam T Component type to search.
+         * \param e_id The entity ID to search.
+         * \return Return the component.
+         * \exception wte_exception Component not found.
+         */
+        template <typename T>
+        inline static const std::shared_ptr<T> set_component_quiet(const entity_id& e_id) {
+            const auto results = _world.equal_range(e_id);
+
+            for(auto it = results.first; it != results.second; it++) {
+                if(std::dynamic_pointer_cast<T>(it->second))
+                    return std::static_pointer_cast<T>(it->second);
+            }
+            throw exception(
+                exception_item("Entity: " + std::to_string(e_id) + " - Component not found", "World", 4));
+        };
+
         /*!
          * \brief Read the value of a component by type for an entity.
          * \tparam T Component type to search.
@@ -309,6 +419,89 @@ class world final : private manager<world> {
             return temp_components;
         };
 
+        /*!
+         * \brief Return a 'set' container for all components of a type, skipping sleeping entities.
+         * 
+         * Does not wake the entities returned.
+         * 
+         * \tparam T Component type to search.
+         * \return Returns a container of components of all the same type.
+         */
+        template <typename T>
+        inline static const component_container<T> set_active_components(void) {
+            component_container<T> temp_components;
+
+            world_mtx.lock();
+            entity_mtx.lock();
+            for(auto& it: _world) {
+                if(sleeping.find(it.first) != sleeping.end()) continue;
+                if(std::dynamic_pointer_cast<T>(it.second))
+                    temp_components.insert(std::make_pair(it.first, std::static_pointer_cast<T>(it.second)));
+            }
+            entity_mtx.unlock();
+            world_mtx.unlock();
+            return temp_components;
+        };
+
+        /*!
+         * \brief Return a 'get' container for all components of a type, skipping sleeping entities.
+         * \tparam T Component type to search.
+         * \return Returns a constant container of components of all the same type.
+         */
+        template <typename T>
+        inline static const const_component_container<T> get_active_components(void) {
+            const_component_container<T> temp_components;
+
+            world_mtx.lock();
+            entity_mtx.lock();
+            for(auto& it: _world) {
+                if(sleeping.find(it.first) != sleeping.end()) continue;
+                if(std::dynamic_pointer_cast<T>(it.second))
+                    temp_components.insert(std::make_pair(it.first, std::static_pointer_cast<T>(it.second)));
+            }
+            entity_mtx.unlock();
+            world_mtx.unlock();
+            return temp_components;
+        };
+
+        /*!
+         * \brief Put an entity to sleep.
+         * 
+         * Sleeping entities are skipped by the movement, animation and colision systems.
+         * They are woken by a component write, a colision or a message.
+         * 
+         * \param e_id Entity ID to put to sleep.
+         * \return True if set, false if the entity does not exist.
+         */
+        static const bool sleep_entity(const entity_id& e_id);
+
+        /*!
+         * \brief Wake a sleeping entity.
+         * 
+         * Also resets the entity's idle time.
+         * 
+         * \param e_id Entity ID to wake.
+         * \return True if set, false if the entity does not exist.
+         */
+        static const bool wake_entity(const entity_id& e_id);
+
+        /*!
+         * \brief Wake a group of entities in one step.
+         * 
+         * Same as wake_entity for each, with the entities locked once.
+         * Entities that do not exist are skipped.
+         * 
+         * \param e_ids Entity IDs to wake.
+         */
+        static void wake_entities(const std::vector<entity_id>& e_ids);
+
+        /*!
+         * \brief Check if an entity is sleeping.
+         * \param e_id Entity ID to check.
+         * \return True if sleeping, false if awake or does not exist.
+         */
+        static const bool is_sleeping(const entity_id& e_id);
+
         inline static const entity_id ENTITY_ERROR = 0;  //!<  Entity error code.
         inline static const entity_id ENTITY_START = 1;  //!<  Start of Entity counter.
         inline static const entity_id ENTITY_MAX =       //!<  Entity max value.
@@ -319,11 +512,48 @@ class world final : private manager<world> {
         ~world() = default;
 
         static void clear(void);  //  Clear the entity manager.
+        /*
+         * Record a component being added or removed.  Call with world_mtx held.
+         * If the log fills up it is dropped and marked as reset.
+         */
+        static void log_change(const entity_id& e_id, const cmp::component_csptr& comp, const bool& added);
+        /*
+         * Swap the change log with an empty one.
+         * Returns true if the log was reset since the last call,
+         * in which case the changes are incomplete and the world should be read again.
+         */
+        static const bool take_changes(std::vector<component_change>& changes);
+        //  Put idle entities to sleep.  Called by the engine each tick.
+        static void update_sleeping(void);
+        //  Add an entity to entity_vec.  Call with entity_mtx held.
+        static void list_entity(const entity_id& e_id, const std::string& name);
+        //  Remove an entity from entity_vec in constant time.  Call with entity_mtx held.
+        static void unlist_entity(const entity_id& e_id);
 
         static entity_id entity_counter;  //  Last Entity ID used.
         static entities entity_vec;       //  Container for all entities.
+        //  Position of each entity in entity_vec.
+        static std::unordered_map<entity_id, std::size_t> entity_index;
+        //  Lookup indexes for entity names and IDs.
+        static std::unordered_map<entity_id, std::string> entity_names;
+        static std::unordered_map<std::string, entity_id> entity_ids;
         static world_map _world;          //  Container for all components.
 
+        //  Names of inactive entities.
+        static std::unordered_map<entity_id, std::string> inactive;
+        //  Components of inactive entities.
+        static world_map _inactive;
+
+        //  Components added and removed since the changes were last taken.
+        static std::vector<component_change> change_log;
+        static bool change_reset;  //  Set when the log is dropped.
+        inline static const std::size_t CHANGE_LOG_MAX = 65536;
+
+        //  Last tick each awake entity was touched.
+        static std::unordered_map<entity_id, int64_t> last_touched;
+        //  Entities currently sleeping.
+        static std::unordered_set<entity_id> sleeping;
+
         static std::mutex entity_mtx;
         static std::mutex world_mtx;
 };
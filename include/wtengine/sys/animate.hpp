@@ -27,6 +27,7 @@ class animate final : public system {
          * \brief Gets all animation components and processes their run members.
          * 
          * The entity must also have the visible component and is set visible to be drawn.
+         * Sleeping entities are skipped, as are components that do not need a redraw.
          */
         void run(void) override;
 };
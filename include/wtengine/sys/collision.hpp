@@ -10,6 +10,8 @@
 #ifndef WTE_SYS_COLISION_HPP
 #define WTE_SYS_COLISION_HPP
 
+#include <vector>
+
 #include "wtengine/sys/system.hpp"
 
 namespace wte::sys {
@@ -25,8 +27,22 @@ class colision final : public system {
 
         /*!
          * \brief Selects components by team, then tests each team to see if there is a colision.
+         * 
+         * Pairs where both entities are sleeping are skipped.
+         * Entities that colide are woken.
          */
         void run(void) override;
+
+    private:
+        //  Hitbox data for one entity, gathered once per run.
+        struct colider {
+            entity_id e_id;
+            cmp::const_comp_ptr<cmp::hitbox> hitbox;
+            cmp::const_comp_ptr<cmp::location> location;
+            bool sleeping;
+        };
+
+        std::vector<colider> coliders;  //  Kept between runs to reuse storage.
 };
 
 }  //  end namespace wte::sys
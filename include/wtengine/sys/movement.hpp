@@ -11,6 +11,8 @@
 #define WTE_SYS_MOVEMENT_HPP
 
 #include <cmath>
+#include <vector>
+#include <limits>
 
 #include "wtengine/sys/system.hpp"
 
@@ -29,8 +31,30 @@ class movement final : public system {
          * \brief All entities with a velocity component will be moved.
          * 
          * Also checks entities are within their bounding boxes.
+         * Motion and bounding box data are packed into flat arrays
+         * and processed in a single pass.  Sleeping entities are skipped
+         * and only locations that changed are written back.
          */
         void run(void) override;
+
+    private:
+        //  Apply velocity and bounding box limits along one axis.
+        static void integrate(
+            float* pos,
+            const float* vel,
+            const float* min,
+            const float* max,
+            const std::size_t& count
+        );
+
+        //  Entities being processed this run, and their locations.
+        std::vector<entity_id> ids;
+        std::vector<cmp::location*> locations;
+        //  Entities moved this run.
+        std::vector<entity_id> moved;
+        //  Packed movement data.  Kept between runs to reuse their storage.
+        std::vector<float> pos_x, pos_y, old_x, old_y, vel_x, vel_y;
+        std::vector<float> min_x, min_y, max_x, max_y;
 };
 
 }  //  namespace wte::sys
@@ -22,6 +22,10 @@ namespace wte::sys {
 /*!
  * \class system
  * \brief Interface class for creating Systems.
+ * 
+ * When the engine is built with the render thread, systems run while it draws.
+ * Systems hold the display while they run unless created without it.
+ * Only create, load or draw to bitmaps from systems that hold the display.
  */
 class system {
     public:
@@ -32,8 +36,9 @@ class system {
         //!  Override this to create custom System run method.
         virtual void run(void) = 0;
 
-        const std::string name;  //!<  System name.
-        const bool timed;        //!<  Bind system to timer.
+        const std::string name;    //!<  System name.
+        const bool timed;          //!<  Bind system to timer.
+        const bool needs_display;  //!<  Hold the display while running.
 
     protected:
         /*!
@@ -42,7 +47,7 @@ class system {
          */
         system(
             const std::string& n
-        ) : name(n), timed(true) {};
+        ) : name(n), timed(true), needs_display(true) {};
 
         /*!
          * \brief Create a new System object.
@@ -52,7 +57,20 @@ class system {
         system(
             const std::string& n,
             const bool& t
-        ) : name(n), timed(t) {};
+        ) : name(n), timed(t), needs_display(true) {};
+
+        /*!
+         * \brief Create a new System object.
+         * \param n System name.
+         * \param t Flag to bind to timer.
+         * \param d Flag to hold the display while running.
+         *           Pass false only if the system never touches bitmaps.
+         */
+        system(
+            const std::string& n,
+            const bool& t,
+            const bool& d
+        ) : name(n), timed(t), needs_display(d) {};
 };
 
 /*!
@@ -0,0 +1,202 @@
+/*!
+ * wtengine | File:  msg_trace.cpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+#include "wtengine/_debug/msg_trace.hpp"
+
+namespace wte {
+
+#if WTE_DEBUG_MODE  //  Debug mode set if true
+
+std::vector<char> msg_trace::ring;
+std::atomic<std::size_t> msg_trace::head = 0;
+std::atomic<std::size_t> msg_trace::tail = 0;
+std::vector<bool> msg_trace::described;
+std::vector<char> msg_trace::scratch;
+std::atomic<bool> msg_trace::_is_running = false;
+std::size_t msg_trace::_dropped = 0;
+std::thread msg_trace::writer;
+std::ofstream msg_trace::trace_file;
+
+const std::size_t& msg_trace::dropped = msg_trace::_dropped;
+
+/*
+ *
+ */
+const bool msg_trace::start(void) {
+    if(_is_running) return false;
+    try {
+        trace_file.open(FILE_NAME, std::ios::binary | std::ios::trunc);
+        if(!trace_file.is_open()) return false;
+
+        trace::header hdr;
+        std::memcpy(hdr.magic, trace::MAGIC, sizeof(hdr.magic));
+        hdr.version = trace::VERSION;
+        trace_file.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+
+        ring.assign(RING_SIZE, 0);
+        head = 0;
+        tail = 0;
+        described.assign(1, true);  //  The empty string is implied.
+        _dropped = 0;
+
+        _is_running = true;
+        writer = std::thread(&msg_trace::run);
+    } catch(...) {
+        _is_running = false;
+        trace_file.close();
+        return false;
+    }
+    return true;
+}
+
+/*
+ *
+ */
+void msg_trace::stop(void) {
+    if(!_is_running) return;
+    _is_running = false;
+    if(writer.joinable()) writer.join();
+    flush();
+
+    //  Note how much was lost.
+    if(_dropped > 0) {
+        const uint64_t count = _dropped;
+        trace::entry_header ent;
+        ent.size = sizeof(ent) + sizeof(count);
+        ent.type = trace::ENTRY_DROPPED;
+        ent.reserved = 0;
+        trace_file.write(reinterpret_cast<const char*>(&ent), sizeof(ent));
+        trace_file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    trace_file.close();
+    ring.clear();
+    ring.shrink_to_fit();
+}
+
+/*
+ *
+ */
+void msg_trace::run(void) {
+    while(_is_running) {
+        flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+/*
+ *
+ */
+void msg_trace::flush(void) {
+    const std::size_t start = tail.load(std::memory_order_relaxed);
+    const std::size_t end = head.load(std::memory_order_acquire);
+    if(start == end) return;
+
+    //  Write out the used part of the ring, which may wrap around.
+    const std::size_t pos = start & (RING_SIZE - 1);
+    const std::size_t len = end - start;
+    const std::size_t first = std::min(len, RING_SIZE - pos);
+    trace_file.write(ring.data() + pos, first);
+    if(first < len) trace_file.write(ring.data(), len - first);
+
+    tail.store(end, std::memory_order_release);
+}
+
+/*
+ *
+ */
+const bool msg_trace::push(const trace::entry_type& type, const std::vector<char>& body) {
+    trace::entry_header ent;
+    ent.size = static_cast<uint16_t>(sizeof(ent) + body.size());
+    ent.type = type;
+    ent.reserved = 0;
+
+    const std::size_t start = head.load(std::memory_order_relaxed);
+    const std::size_t used = start - tail.load(std::memory_order_acquire);
+    if(RING_SIZE - used < ent.size) return false;
+
+    //  Copy into the ring, wrapping around the end.
+    auto copy = [](std::size_t at, const char* data, const std::size_t& len) {
+        at &= (RING_SIZE - 1);
+        const std::size_t first = std::min(len, RING_SIZE - at);
+        std::memcpy(ring.data() + at, data, first);
+        if(first < len) std::memcpy(ring.data(), data + first, len - first);
+    };
+    copy(start, reinterpret_cast<const char*>(&ent), sizeof(ent));
+    copy(start + sizeof(ent), body.data(), body.size());
+
+    head.store(start + ent.size, std::memory_order_release);
+    return true;
+}
+
+/*
+ *
+ */
+const bool msg_trace::describe(const intern_id& id) {
+    if(id < described.size() && described[id]) return true;
+
+    const std::string& str = intern::str(id);
+    const uint32_t id32 = static_cast<uint32_t>(id);
+    const std::size_t len = std::min<std::size_t>(str.size(), trace::MAX_STRING);
+    scratch.resize(sizeof(id32) + len);
+    std::memcpy(scratch.data(), &id32, sizeof(id32));
+    std::memcpy(scratch.data() + sizeof(id32), str.data(), len);
+    if(!push(trace::ENTRY_STRING, scratch)) return false;
+
+    //  Only mark once written, so a dropped string is sent again.
+    if(id >= described.size()) described.resize(id + 1, false);
+    described[id] = true;
+    return true;
+}
+
+/*
+ *
+ */
+void msg_trace::record(const message& msg, const trace::message_event& event) {
+    if(!_is_running) return;
+
+    if(!describe(msg.get_sys_id()) || !describe(msg.get_cmd_id())) {
+        _dropped++;
+        return;
+    }
+
+    trace::message_record rec;
+    rec.proc_time = engine_time::check();
+    rec.timer = msg.get_timer();
+    rec.sys = static_cast<uint32_t>(msg.get_sys_id());
+    rec.cmd = static_cast<uint32_t>(msg.get_cmd_id());
+    rec.event = event;
+
+    //  Entity names follow the record, up to the size limit.
+    const std::size_t to_size = std::min<std::size_t>(msg.get_to().size(), trace::MAX_STRING);
+    const std::size_t from_size = std::min<std::size_t>(msg.get_from().size(), trace::MAX_STRING);
+    rec.to_size = static_cast<uint32_t>(to_size);
+    rec.from_size = static_cast<uint32_t>(from_size);
+    scratch.resize(sizeof(rec));
+    scratch.insert(scratch.end(), msg.get_to().begin(), msg.get_to().begin() + to_size);
+    scratch.insert(scratch.end(), msg.get_from().begin(), msg.get_from().begin() + from_size);
+
+    //  Then rebuild the argument string, up to the size limit.
+    const std::size_t args_start = scratch.size();
+    const std::size_t count = msg.num_args();
+    for(std::size_t i = 0; i < count; i++) {
+        if(i > 0) scratch.push_back(';');
+        const std::string_view arg = msg.arg(i);
+        scratch.insert(scratch.end(), arg.begin(), arg.end());
+        if(scratch.size() - args_start >= trace::MAX_ARGS) break;
+    }
+    scratch.resize(std::min<std::size_t>(scratch.size(), args_start + trace::MAX_ARGS));
+    rec.args_size = static_cast<uint32_t>(scratch.size() - args_start);
+    std::memcpy(scratch.data(), &rec, sizeof(rec));
+
+    if(!push(trace::ENTRY_MESSAGE, scratch)) _dropped++;
+}
+
+#endif  //  WTE_DEBUG_MODE
+
+}  //  end namespace wte
@@ -7,6 +7,8 @@
  * \date 2019-2022
  */
 
+#include <algorithm>
+
 #include "wtengine/_globals/commands.hpp"
 
 namespace wte {
@@ -19,8 +21,41 @@ const bool commands::add(
     const std::size_t& nargs,
     const std::function<void(const msg_args&)>& func
 ) {
-    auto ret = _commands.insert(std::make_pair(cmd, std::make_pair(nargs, func)));
-    return ret.second;
+    return add(cmd, nargs, [func](const message& msg) { func(msg.get_args()); });
+}
+
+/*
+ *
+ */
+const bool commands::add(
+    const std::string& cmd,
+    const std::size_t& nargs,
+    const std::function<void(const message&)>& func
+) {
+    if(!func) return false;
+    const intern_id id = intern::id(cmd);
+    auto it = std::lower_bound(_commands.begin(), _commands.end(), id,
+        [](const command& c, const intern_id& i) { return c.id < i; });
+    if(it != _commands.end() && it->id == id) return false;
+    _commands.insert(it, command{ id, nargs, func });
+    return true;
+}
+
+/*
+ *
+ */
+const bool commands::contains(const intern_id& cmd) const {
+    return (find(cmd) != nullptr);
+}
+
+/*
+ *
+ */
+const commands::command* commands::find(const intern_id& cmd) const {
+    auto it = std::lower_bound(_commands.begin(), _commands.end(), cmd,
+        [](const command& c, const intern_id& i) { return c.id < i; });
+    if(it == _commands.end() || it->id != cmd) return nullptr;
+    return &(*it);
 }
 
 /*
@@ -30,10 +65,10 @@ void commands::process_messages(
     const message_container& messages
 ) {
     for(auto& it: messages) {
-        auto res = _commands.find(it.get_cmd());
+        const command* res = find(it.get_cmd_id());
+        if(res == nullptr) continue;
         //  Check to make sure there are enough arguments to run the command.
-        if(res != _commands.end() && it.num_args() >= res->second.first)
-            res->second.second(it.get_args());
+        if(it.num_args() >= res->nargs) res->func(it);
     }
 }
 
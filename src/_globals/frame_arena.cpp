@@ -0,0 +1,122 @@
+/*!
+ * wtengine | File:  frame_arena.cpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+#include "wtengine/_globals/frame_arena.hpp"
+
+#include <new>
+#include <cstring>
+#include <string>
+
+#include "wtengine/_debug/logger.hpp"
+#include "wtengine/_globals/_defines.hpp"
+
+namespace wte {
+
+unsigned char* frame_arena::buffer = nullptr;
+std::size_t frame_arena::_capacity = 0;
+std::size_t frame_arena::offset = 0;
+std::vector<std::pair<unsigned char*, std::size_t>> frame_arena::overflow;
+std::size_t frame_arena::overflow_used = 0;
+std::atomic<std::size_t> frame_arena::live = 0;
+//  Static objects are initialized on the main thread.
+const std::thread::id frame_arena::main_thread = std::this_thread::get_id();
+
+const std::size_t& frame_arena::capacity = frame_arena::_capacity;
+
+/*
+ *
+ */
+void* frame_arena::allocate(const std::size_t& bytes, const std::size_t& align) {
+    const std::size_t space = header_space(align);
+
+    if(std::this_thread::get_id() != main_thread) {
+        unsigned char* block = static_cast<unsigned char*>(
+            ::operator new(space + bytes, std::align_val_t(heap_align(align))));
+        set_origin(block + space, FROM_HEAP);
+        return block + space;
+    }
+
+    if constexpr (build_options.debug_mode) live++;
+
+    //  Bump the offset in the main buffer, leaving room for the header.
+    //  Align the address rather than the offset, for alignments larger than the buffer's.
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer);
+    std::size_t start = ((base + offset + sizeof(header) + align - 1) & ~(align - 1)) - base;
+    if(buffer != nullptr && start + bytes <= _capacity) {
+        offset = start + bytes;
+        set_origin(buffer + start, FROM_ARENA);
+        return buffer + start;
+    }
+
+    //  Main buffer is full, use an extra block until the next reset.
+    const std::size_t size = bytes + space + align;
+    unsigned char* block = static_cast<unsigned char*>(
+        ::operator new(size, std::align_val_t(alignof(std::max_align_t))));
+    overflow.push_back(std::make_pair(block, size));
+    overflow_used += size;
+    start = (reinterpret_cast<std::uintptr_t>(block) + sizeof(header) + align - 1) & ~(align - 1);
+    set_origin(reinterpret_cast<void*>(start), FROM_ARENA);
+    return reinterpret_cast<void*>(start);
+}
+
+/*
+ *
+ */
+void frame_arena::deallocate(void* ptr, const std::size_t& bytes, const std::size_t& align) {
+    if(ptr == nullptr) return;
+
+    header hdr;
+    std::memcpy(&hdr, static_cast<unsigned char*>(ptr) - sizeof(header), sizeof(header));
+    if(hdr.origin == FROM_HEAP) {
+        ::operator delete(static_cast<unsigned char*>(ptr) - header_space(align),
+                          std::align_val_t(heap_align(align)));
+        return;
+    }
+    //  Arena memory is reclaimed by the reset.
+    if constexpr (build_options.debug_mode) live--;
+}
+
+/*
+ *
+ */
+void frame_arena::reset(void) {
+    //  Containers still holding arena memory would be left pointing at released memory.
+    //  Log it rather than throw, this runs at the end of the engine loop.
+    if constexpr (build_options.debug_mode) {
+        const std::size_t count = live.exchange(0);
+        if(count > 0) logger_add(std::to_string(count) + " frame allocations outlived the frame",
+            "Frame arena", 0, engine_time::check());
+    }
+
+    if(!overflow.empty()) {
+        //  Grow the main buffer to fit everything used this frame.
+        const std::size_t needed = offset + overflow_used;
+        for(auto& it: overflow)
+            ::operator delete(it.first, std::align_val_t(alignof(std::max_align_t)));
+        overflow.clear();
+        overflow_used = 0;
+
+        if(buffer != nullptr)
+            ::operator delete(buffer, std::align_val_t(alignof(std::max_align_t)));
+        _capacity = (_capacity * 2 > needed ? _capacity * 2 : needed);
+        buffer = static_cast<unsigned char*>(
+            ::operator new(_capacity, std::align_val_t(alignof(std::max_align_t))));
+    }
+    offset = 0;
+}
+
+/*
+ *
+ */
+void frame_arena::set_origin(void* ptr, const uint64_t& origin) {
+    const header hdr = { origin };
+    std::memcpy(static_cast<unsigned char*>(ptr) - sizeof(header), &hdr, sizeof(header));
+}
+
+}  //  end namespace wte
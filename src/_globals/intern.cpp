@@ -0,0 +1,54 @@
+/*!
+ * wtengine | File:  intern.cpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+#include "wtengine/_globals/intern.hpp"
+
+namespace wte {
+
+/*
+ *
+ */
+intern::table& intern::get_table(void) {
+    static table _table;
+    return _table;
+}
+
+/*
+ *
+ */
+const intern_id intern::id(const std::string& str) {
+    table& t = get_table();
+    t.mtx.lock();
+    auto it = t.ids.find(str);
+    if(it != t.ids.end()) {
+        const intern_id found_id = it->second;
+        t.mtx.unlock();
+        return found_id;
+    }
+
+    const intern_id new_id = t.strings.size();
+    t.strings.push_back(str);
+    t.ids.insert(std::make_pair(str, new_id));
+    t.mtx.unlock();
+    return new_id;
+}
+
+/*
+ *
+ */
+const std::string& intern::str(const intern_id& i) {
+    table& t = get_table();
+    t.mtx.lock();
+    //  Deque elements do not move, safe to return after unlocking.
+    const std::string& result = (i < t.strings.size() ? t.strings[i] : t.strings[EMPTY]);
+    t.mtx.unlock();
+    return result;
+}
+
+}  //  end namespace wte
@@ -15,44 +15,48 @@ namespace wte {
  *
  */
 message::message(const std::string& s, const std::string& c, const std::string& a) :
-timer(-1), sys(s), to(""), from(""), cmd(c) { split_args(a); }
+timer(-1), sys(intern::id(s)), to(""), from(""), cmd(intern::id(c)),
+is_split(false) { set_args(a); }
 
 /*
  *
  */
 message::message(const int64_t& e, const std::string& s, const std::string& c, const std::string& a) :
-timer(e), sys(s), to(""), from(""), cmd(c) { split_args(a); }
+timer(e), sys(intern::id(s)), to(""), from(""), cmd(intern::id(c)),
+is_split(false) { set_args(a); }
 
 /*
  *
  */
 message::message(const std::string& s, const std::string& t, const std::string& f, const std::string& c, const std::string& a) :
-timer(-1), sys(s), to(t), from(f), cmd(c) { split_args(a); }
+timer(-1), sys(intern::id(s)), to(t), from(f), cmd(intern::id(c)),
+is_split(false) { set_args(a); }
 
 /*
  *
  */
 message::message(const int64_t& e, const std::string& s, const std::string& t, const std::string& f, const std::string& c, const std::string& a) :
-timer(e), sys(s), to(t), from(f), cmd(c) { split_args(a); }
+timer(e), sys(intern::id(s)), to(t), from(f), cmd(intern::id(c)),
+is_split(false) { set_args(a); }
 
 /*
  *
  */
-const bool message::operator<(const message& m) const { return timer < m.timer; }
+message::message(const int64_t& e, const intern_id& s, const std::string& t, const std::string& f, const intern_id& c, const std::string& a) :
+timer(e), sys(s), to(t), from(f), cmd(c), is_split(false) { set_args(a); }
 
 /*
  *
  */
-void message::split_args(const std::string& a) {
-    if(a == "") args.push_back("");
-    else {
-        std::stringstream arg_stream(a);
-        std::string segment;
+const bool message::operator<(const message& m) const { return timer < m.timer; }
 
-        while(std::getline(arg_stream, segment, ';')) {
-            args.push_back(segment);
-        }
-    }
+/*
+ *
+ */
+void message::set_args(const std::string& a) {
+    //  A trailing delimiter does not start a new argument.
+    if(!a.empty() && a.back() == ';') args.assign(a, 0, a.size() - 1);
+    else args = a;
 }
 
 /*
@@ -63,41 +67,89 @@ const int64_t message::get_timer(void) const { return timer; }
 /*
  *
  */
-const std::string message::get_sys(void) const { return sys; }
+const std::string& message::get_sys(void) const { return intern::str(sys); }
+
+/*
+ *
+ */
+const intern_id message::get_sys_id(void) const { return sys; }
+
+/*
+ *
+ */
+const std::string& message::get_to(void) const { return to; }
 
 /*
  *
  */
-const std::string message::get_to(void) const { return to; }
+const std::string& message::get_from(void) const { return from; }
 
 /*
  *
  */
-const std::string message::get_from(void) const { return from; }
+const std::string& message::get_cmd(void) const { return intern::str(cmd); }
 
 /*
  *
  */
-const std::string message::get_cmd(void) const { return cmd; }
+const intern_id message::get_cmd_id(void) const { return cmd; }
 
 /*
  *
  */
-const std::size_t message::num_args(void) const { return args.size(); }
+const std::size_t message::num_args(void) const {
+    return std::count(args.begin(), args.end(), ';') + 1;
+}
 
 /*
  *
  */
-const msg_args message::get_args(void) const { return args; }
+const msg_args& message::get_args(void) const {
+    if(!is_split) {
+        const std::size_t count = num_args();
+        split_cache.reserve(count);
+        for(std::size_t i = 0; i < count; i++) split_cache.emplace_back(arg(i));
+        is_split = true;
+    }
+    return split_cache;
+}
 
 /*
  *
  */
 const std::string message::get_arg(const std::size_t& pos) const {
-    if(pos >= args.size()) return "";  //  Out of range, return empty string.
-    else return args[pos];
+    return std::string(arg(pos));
+}
+
+/*
+ *
+ */
+const std::string_view message::arg(const std::size_t& pos) const {
+    //  Find the start of the argument.
+    std::size_t start = 0;
+    for(std::size_t i = 0; i < pos; i++) {
+        start = args.find(';', start);
+        if(start == std::string::npos) return std::string_view();  //  Out of range.
+        start++;
+    }
+    std::size_t end = args.find(';', start);
+    if(end == std::string::npos) end = args.size();
+    return std::string_view(args).substr(start, end - start);
+}
+
+/*
+ *
+ */
+message& message::set_payload(const msg_payload& p) {
+    payload = p;
+    return *this;
 }
 
+/*
+ *
+ */
+const msg_payload& message::get_payload(void) const { return payload; }
+
 /*
  *
  */
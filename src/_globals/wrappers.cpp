@@ -100,6 +100,36 @@ const int al_bitmap::get_width(void) const { return al_get_bitmap_width(_al_bitm
  */
 const int al_bitmap::get_height(void) const { return al_get_bitmap_height(_al_bitmap); }
 
+/*
+ *
+ */
+const bool al_bitmap::pack(ALLEGRO_BITMAP* atlas, const int& x, const int& y) {
+    if(_al_bitmap == NULL || atlas == NULL) return false;
+    const int w = get_width(), h = get_height();
+
+    ALLEGRO_BITMAP* region = al_create_sub_bitmap(atlas, x, y, w, h);
+    if(!region) return false;
+
+    //  Copy the pixels as they are, including alpha.
+    ALLEGRO_STATE state;
+    al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+    al_set_target_bitmap(atlas);
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    al_draw_bitmap(_al_bitmap, x, y, 0);
+    al_restore_state(&state);
+
+    al_destroy_bitmap(_al_bitmap);
+    _al_bitmap = region;
+    return true;
+}
+
+/*
+ *
+ */
+const bool al_bitmap::ispacked(void) const {
+    return (_al_bitmap != NULL && al_is_sub_bitmap(_al_bitmap));
+}
+
 /*
  *
  */
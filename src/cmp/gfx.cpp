@@ -9,6 +9,10 @@
 
 #include "wtengine/cmp/gfx.hpp"
 
+#include <cassert>
+
+#include "wtengine/mgr/renderer.hpp"
+
 namespace wte::cmp::gfx {
 
 /*
@@ -20,12 +24,29 @@ gfx::gfx(
     const std::function<void(const entity_id&)>& func
 ) : layer(l), visible(true), rotated(false), direction(0.0f),
 scale_factor_x(1.0f), scale_factor_y(1.0f),
-_bitmap(bmp), tinted(false), animate(func) {}
+_bitmap(bmp), revision(0), tinted(false),
+animate([func](const entity_id& e_id, gfx&) { func(e_id); }) {}
+
+/*
+ *
+ */
+gfx::gfx(
+    wte_asset<al_bitmap> bmp,
+    const std::size_t& l,
+    const std::function<void(const entity_id&, gfx&)>& func
+) : layer(l), visible(true), rotated(false), direction(0.0f),
+scale_factor_x(1.0f), scale_factor_y(1.0f),
+_bitmap(bmp), revision(0), tinted(false), animate(func) {}
 
 /*
  *
  */
-void gfx::set_drawing(void) { al_set_target_bitmap(**_bitmap); }
+void gfx::set_drawing(void) {
+    //  Drawing needs the display, see sys::system.
+    if constexpr (build_options.debug_mode) assert(mgr::gfx::renderer::holding_display());
+    revision++;
+    al_set_target_bitmap(**_bitmap);
+}
 
 /*
  *
@@ -18,6 +18,7 @@ motion::motion(
     const float& d,
     const float& xv,
     const float& yv
-) : direction(d), x_vel(xv), y_vel(yv) {}
+) : direction(d), x_vel(xv), y_vel(yv),
+cached_direction(d), dir_x(std::cos(d)), dir_y(std::sin(d)) {}
 
 }  //  end namespace wte::cmp
@@ -21,7 +21,8 @@ overlay::overlay(
     const float& x,
     const float& y,
     const std::function<void(const entity_id&)>& func
-) : gfx(bmp, l, func), pos_x(x), pos_y(y), overlay_font(font) {}
+) : gfx(bmp, l, func), pos_x(x), pos_y(y), overlay_font(font),
+tracked(false), invalidated(true) {}
 
 /*
  *
@@ -35,4 +36,39 @@ void overlay::draw_text(
     al_draw_text(**overlay_font, color, x, y, f, txt.c_str());
 }
 
+/*
+ *
+ */
+void overlay::bind(const std::string& var) {
+    tracked = true;
+    //  Zero revision, so the first check redraws.
+    bindings.push_back(std::make_pair(var, 0));
+}
+
+/*
+ *
+ */
+void overlay::invalidate(void) {
+    tracked = true;
+    invalidated = true;
+}
+
+/*
+ *
+ */
+const bool overlay::needs_redraw(void) {
+    if(!tracked) return true;
+
+    bool changed = invalidated;
+    invalidated = false;
+    for(auto& it: bindings) {
+        const std::size_t rev = mgr::variables::revision(it.first);
+        if(rev != it.second) {
+            it.second = rev;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
 }  //  end namespace wte::cmp
@@ -11,6 +11,12 @@
 
 namespace wte::cmp::gfx {
 
+std::map<
+    const std::tuple<int, int, float, float>,
+    std::weak_ptr<const frame_table>
+> sprite::frame_tables;
+std::mutex sprite::frame_mtx;
+
 /*
  *
  */
@@ -20,19 +26,20 @@ sprite::sprite(
     const float& sw, const float& sh,
     const float& dox, const float& doy,
     const std::size_t& rt) :
-    gfx(bmp, l,[this](const entity_id& e_id) {
+    gfx(bmp, l, [](const entity_id& e_id, gfx& g) {
         //  Define sprite animation process.
-        if(engine_time::check() % rate == 0) {
+        sprite& s = static_cast<sprite&>(g);
+        if(engine_time::check() % s.rate == 0) {
             //  Increment frame.
-            current_frame++;
+            s.current_frame++;
             //  Loop frame.
-            if(current_frame > stop_frame) {
-                current_frame = start_frame;
+            if(s.current_frame > s.stop_frame) {
+                s.current_frame = s.start_frame;
             }
-            //  Calculate the X position in the sprite sheet.
-            sprite_x = (float)((int)(current_frame * sprite_width + sheet_width) % sheet_width);
-            //  Calculate the Y position in the sprite sheet.
-            sprite_y = (float)((int)((current_frame * sprite_width) / sheet_width) * sprite_height);
+            //  Look up the position in the sprite sheet.
+            const frame_region& region = (*s.frames)[s.current_frame % s.frames->size()];
+            s.sprite_x = region.x;
+            s.sprite_y = region.y;
         }
     }),
     sprite_width(sw), sprite_height(sh), draw_offset_x(dox), draw_offset_y(doy),
@@ -42,6 +49,47 @@ sprite::sprite(
     if(rate == 0) rate = 1;
     sheet_width = _bitmap->get_width();
     sheet_height = _bitmap->get_height();
+    frames = get_frames(sheet_width, sheet_height, sprite_width, sprite_height);
+}
+
+/*
+ *
+ */
+const std::shared_ptr<const frame_table> sprite::get_frames(
+    const int& sw, const int& sh, const float& fw, const float& fh
+) {
+    const auto key = std::make_tuple(sw, sh, fw, fh);
+    frame_mtx.lock();
+    auto it = frame_tables.find(key);
+    if(it != frame_tables.end()) {
+        auto table = it->second.lock();
+        if(table) {
+            frame_mtx.unlock();
+            return table;
+        }
+    }
+
+    //  Build the table, one entry for each frame that fits on the sheet.
+    std::size_t count = 1;
+    if(sw > 0 && sh > 0 && fw >= 1.0f && fh >= 1.0f)
+        count = std::max<std::size_t>(1, (std::size_t)(sw / (int)fw) * (std::size_t)(sh / (int)fh));
+    auto table = std::make_shared<frame_table>(count);
+    for(std::size_t i = 0; i < count; i++) {
+        if(sw <= 0) break;
+        //  Calculate the X position in the sprite sheet.
+        (*table)[i].x = (float)((int)(i * fw + sw) % sw);
+        //  Calculate the Y position in the sprite sheet.
+        (*table)[i].y = (float)((int)((i * fw) / sw) * fh);
+    }
+
+    //  Drop tables no longer in use.
+    for(auto t_it = frame_tables.begin(); t_it != frame_tables.end();) {
+        if(t_it->second.expired()) t_it = frame_tables.erase(t_it);
+        else t_it++;
+    }
+    frame_tables.insert_or_assign(key, table);
+    frame_mtx.unlock();
+    return table;
 }
 
 /*
@@ -68,4 +116,9 @@ const bool sprite::set_cycle(const std::string& name) {
     } else return false;
 }
 
+/*
+ *
+ */
+const std::size_t sprite::get_frame(void) const { return current_frame; }
+
 }  //  end namespace wte::cmp
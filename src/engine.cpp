@@ -39,6 +39,8 @@ engine::engine(const int& argc, char** const& argv) {
         exception_item("Failed to load Allegro image addon!", "Main engine", 1));
     if(!al_init_font_addon()) throw runtime_error(
         exception_item("Failed to load Allegro font addon!", "Main engine", 1));
+    if(!al_init_primitives_addon()) throw runtime_error(
+        exception_item("Failed to load Allegro primitives addon!", "Main engine", 1));
     std::cout << "OK!\n";
     config::_flags::audio_installed = al_install_audio();
     //  Input detection.
@@ -110,7 +112,10 @@ engine::engine(const int& argc, char** const& argv) {
         }
     });
 
-    if(build_options.debug_mode) logger::start();
+    if(build_options.debug_mode) {
+        logger::start();
+        msg_trace::start();
+    }
 }
 
 /*
@@ -127,7 +132,10 @@ engine::~engine() {
     al_inhibit_screensaver(false);
     al_uninstall_system();
 
-    if(build_options.debug_mode) logger::stop();
+    if(build_options.debug_mode) {
+        msg_trace::stop();
+        logger::stop();
+    }
 
     initialized = false;
     std::cout << "Done!\n\n";
@@ -187,6 +195,8 @@ void engine::process_new_game(const std::string& game_data) {
     
     //  Clear world and load starting entities.
     mgr::world::clear();
+    mgr::spawner::clear();
+    mgr::gfx::renderer::clear_viewports();
     
     try { new_game(); } catch(exception& e) {
         //  Failed to create new game, abort.
@@ -225,6 +235,7 @@ void engine::process_end_game(void) {
     try { end_game(); } catch(const exception& e) { throw e; }
     //  Clear managers.
     mgr::world::clear();
+    mgr::spawner::clear();
     mgr::systems::clear();
     mgr::messages::clear();
 
@@ -243,8 +254,15 @@ void engine::do_game(void) {
     config::_flags::game_started = false;
     config::_flags::menu_opened = true;
 
+    //  Start the render thread if the engine was built with it.
+    mgr::gfx::renderer::start_thread();
+
     while(config::flags::is_running) {
         /* *** START ENGINE LOOP ******************************************** */
+        //  With a render thread, wait here for events while it draws.
+        if constexpr (build_options.render_thread)
+            al_wait_for_event_timed(main_event_queue, NULL, 0.001f);
+
         input::check_events();  //  Check for input.
 
         if(!config::flags::game_started) {       //  Game not running.
@@ -255,27 +273,47 @@ void engine::do_game(void) {
         //  Also process the on_menu events.
         if(config::flags::menu_opened && al_get_timer_started(main_timer)) {
             al_stop_timer(main_timer);
+            mgr::gfx::renderer::hold_display();
             on_menu_open();
+            mgr::gfx::renderer::release_display();
         }
         if(!config::flags::menu_opened && !al_get_timer_started(main_timer)) {
+            mgr::gfx::renderer::hold_display();
             on_menu_close();
+            mgr::gfx::renderer::release_display();
             al_resume_timer(main_timer);
         }
 
         ALLEGRO_EVENT event;
-        if(al_get_next_event(main_event_queue, &event)) {
+        const bool have_event = al_get_next_event(main_event_queue, &event);
+        //  Call our game logic update on timer events.
+        //  Timer is only running when the game is running.
+        if(have_event && event.type == ALLEGRO_EVENT_TIMER) {
+            //  Set the engine_time object to the current time.
+            engine_time::set(al_get_timer_count(main_timer));
+            //  Take in messages posted from other threads.
+            mgr::messages::merge_staged();
+            //  Read any script messages that are now due.
+            mgr::messages::stream_scripts();
+            //  Run all systems.  They run while the render thread draws,
+            //  systems that need the display take it while they run.
+            mgr::systems::run();
+        }
+
+        //  Take the display for the rest of the frame, handlers and
+        //  commands from here on may create or draw to bitmaps.
+        mgr::gfx::renderer::hold_display();
+
+        if(have_event) {
             switch(event.type) {
-            //  Call our game logic update on timer events.
-            //  Timer is only running when the game is running.
+            //  Finish the game logic update started above.
             case ALLEGRO_EVENT_TIMER:
-                //  Set the engine_time object to the current time.
-                engine_time::set(al_get_timer_count(main_timer));
-                //  Run all systems.
-                mgr::systems::run();
                 //  Process messages.
                 mgr::messages::dispatch();
                 //  Get any spawner messages and pass to handler.
-                mgr::spawner::process_messages(mgr::messages::get("spawner"));
+                mgr::spawner::process_messages(mgr::messages::get(mgr::messages::SYS_SPAWNER));
+                //  Put any idle entities to sleep.
+                mgr::world::update_sleeping();
                 break;
             //  Check if display looses focus.
             case ALLEGRO_EVENT_DISPLAY_SWITCH_OUT:
@@ -298,16 +336,19 @@ void engine::do_game(void) {
         }
 
         //  Get any system messages and pass to handler.
-        cmds.process_messages(mgr::messages::get("system"));
+        cmds.process_messages(mgr::messages::get(mgr::messages::SYS_SYSTEM));
         //  Send audio messages to the audio queue.
-        mgr::audio::process_messages(mgr::messages::get("audio"));
+        mgr::audio::process_messages(mgr::messages::get(mgr::messages::SYS_AUDIO));
 
-        mgr::systems::run_untimed();   //  Run any untimed systems.
-        mgr::gfx::renderer::render();  //  Render the screen.
-        mgr::messages::prune();        //  Delete unprocessed messages.
+        mgr::gfx::renderer::release_display();  //  Done with the display.
+        mgr::systems::run_untimed();            //  Run any untimed systems.
+        mgr::gfx::renderer::render();           //  Render the screen.
+        mgr::messages::prune();                 //  Delete unprocessed messages.
+        frame_arena::reset();                   //  Release this frame's temporaries.
         /* *** END ENGINE LOOP ********************************************** */
     }
 
+    mgr::gfx::renderer::stop_thread();
     wte_unload();
 }
 
@@ -90,23 +90,26 @@ void audio::initialize(void) {
         if(args[0] == "b") audio::music::a::unpause();
     });
     //  Mixer 2
-    cmds.add("sample-play", 2, [](const msg_args& args) {
+    //  Gain, pan and speed are arguments 2 - 4.  A typed float in the
+    //  same payload position is used instead of parsing the argument.
+    cmds.add("sample-play", 2, [](const message& msg) {
+        const msg_args& args = msg.get_args();
         float gain = 1.0f;
         float pan = ALLEGRO_AUDIO_PAN_NONE;
         float speed = 1.0f;
 
-        if(args.size() >= 3) {
-            gain = std::stof(args[2]);
-            if(gain < 0.0f || gain > 1.0f) gain = 1.0f;
-        }
-        if(args.size() >= 4) {
-            pan = std::stof(args[3]);
-            if(pan < -1.0f || pan > 1.0f) pan = ALLEGRO_AUDIO_PAN_NONE;
-        }
-        if(args.size() >= 5) {
-            speed = std::stof(args[4]);
-            if(speed <= 0.0f || speed > 2.0f) speed = 1.0f;
-        }
+        if(const float* value = msg.get_value<float>(2)) gain = *value;
+        else if(args.size() >= 3) gain = std::stof(args[2]);
+        if(gain < 0.0f || gain > 1.0f) gain = 1.0f;
+
+        if(const float* value = msg.get_value<float>(3)) pan = *value;
+        else if(args.size() >= 4) pan = std::stof(args[3]);
+        if(pan != ALLEGRO_AUDIO_PAN_NONE && (pan < -1.0f || pan > 1.0f)) pan = ALLEGRO_AUDIO_PAN_NONE;
+
+        if(const float* value = msg.get_value<float>(4)) speed = *value;
+        else if(args.size() >= 5) speed = std::stof(args[4]);
+        if(speed <= 0.0f || speed > 2.0f) speed = 1.0f;
+
         audio::sample::play(
             mgr::assets<al_sample>::get<al_sample>(args[0]),
             args[1], gain, pan, speed
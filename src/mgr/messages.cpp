@@ -13,20 +13,125 @@ namespace wte::mgr {
 
 template <> bool manager<messages>::initialized = false;
 
-message_container messages::_messages;
-std::ofstream messages::debug_log_file;
+messages::msg_queues messages::_untimed;
+std::map<int64_t, messages::msg_queues> messages::_timed;
+std::size_t messages::_undelivered = 0;
+
+std::atomic<messages::staging_buffer*> messages::staging_list = nullptr;
+thread_local messages::staging_owner messages::staging;
+std::vector<messages::script_stream> messages::streams;
+//  Static objects are initialized on the main thread.
+const std::thread::id messages::main_thread = std::this_thread::get_id();
+
+const std::size_t& messages::undelivered = messages::_undelivered;
 
 /*
  *
  */
-void messages::clear(void) { _messages.clear(); }
+void messages::clear(void) {
+    //  Discard anything staged by other threads.
+    for(staging_buffer* b = staging_list.load(std::memory_order_acquire); b != nullptr;
+        b = b->next.load(std::memory_order_acquire)) {
+        staged_msg* node = b->head.exchange(nullptr, std::memory_order_acquire);
+        while(node != nullptr) {
+            staged_msg* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+    //  Close any scripts being streamed.
+    for(auto& it: streams) al_fclose(it.file);
+    streams.clear();
+
+    _undelivered = 0;
+    _untimed.clear();
+    _timed.clear();
+}
 
 /*
  *
  */
 void messages::add(const message& msg) {
-    _messages.insert(_messages.begin(), msg);
-    if(msg.is_timed_event()) std::sort(_messages.begin(), _messages.end());
+    if(std::this_thread::get_id() == main_thread) {
+        route(msg);
+        return;
+    }
+
+    //  Off the main thread, push onto this thread's staging list.
+    staging_buffer* buffer = get_staging_buffer();
+    staged_msg* node = new staged_msg(msg);
+    node->next = buffer->head.load(std::memory_order_relaxed);
+    while(!buffer->head.compare_exchange_weak(
+        node->next, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+/*
+ *
+ */
+void messages::route(const message& msg) {
+    if(msg.is_timed_event()) _timed[msg.get_timer()][msg.get_sys_id()].push_back(msg);
+    else _untimed[msg.get_sys_id()].push_back(msg);
+}
+
+/*
+ *
+ */
+messages::staging_buffer* messages::get_staging_buffer(void) {
+    if(staging.buffer != nullptr) return staging.buffer;
+
+    //  Claim a buffer released by a thread that has exited.
+    staging_buffer* tail = nullptr;
+    for(staging_buffer* b = staging_list.load(std::memory_order_acquire); b != nullptr;
+        b = b->next.load(std::memory_order_acquire)) {
+        bool expected = false;
+        if(b->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            staging.buffer = b;
+            return b;
+        }
+        tail = b;
+    }
+
+    //  None free, append a new buffer to the end of the list.
+    staging_buffer* buffer = new staging_buffer;
+    staging_buffer* expected = nullptr;
+    if(tail == nullptr) {
+        if(staging_list.compare_exchange_strong(expected, buffer, std::memory_order_acq_rel)) {
+            staging.buffer = buffer;
+            return buffer;
+        }
+        tail = expected;
+    }
+    while(true) {
+        expected = nullptr;
+        if(tail->next.compare_exchange_weak(expected, buffer, std::memory_order_acq_rel)) break;
+        if(expected != nullptr) tail = expected;
+    }
+    staging.buffer = buffer;
+    return buffer;
+}
+
+/*
+ *
+ */
+void messages::merge_staged(void) {
+    for(staging_buffer* b = staging_list.load(std::memory_order_acquire); b != nullptr;
+        b = b->next.load(std::memory_order_acquire)) {
+        //  Take the whole list, then reverse it into posting order.
+        staged_msg* node = b->head.exchange(nullptr, std::memory_order_acquire);
+        staged_msg* ordered = nullptr;
+        while(node != nullptr) {
+            staged_msg* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+        while(ordered != nullptr) {
+            staged_msg* next = ordered->next;
+            route(ordered->msg);
+            delete ordered;
+            ordered = next;
+        }
+    }
 }
 
 /*
@@ -37,72 +142,95 @@ void messages::dispatch(void) {
         mgr::world::set_components<cmp::dispatcher>();
 
     while(true) {  //  Infinite loop to verify all current messages are processed.
-        message_container temp_msgs = get("entities");
+        message_container temp_msgs = get(SYS_ENTITIES);
         if(temp_msgs.empty()) break;  //  No messages, end while(true) loop.
 
-        //  For all messages, check each dispatch component.
-        for(auto& m_it: temp_msgs) { for(auto& c_it: dispatch_components) {
+        //  Resolve each message to its entity and pass to its dispatcher.
+        for(auto& m_it: temp_msgs) {
+            const entity_id e_id = mgr::world::get_id(m_it.get_to());
+            auto c_it = dispatch_components.find(e_id);
+            if(e_id == mgr::world::ENTITY_ERROR || c_it == dispatch_components.end()) {
+                _undelivered++;
+                continue;
+            }
             try {
-                if(m_it.get_to() == mgr::world::get_name(c_it.first)) {
-                    c_it.second->handle_msg(c_it.first, m_it);
-                    break;  //  Found, stop checking dispatch components.
-                }
+                mgr::world::wake_entity(e_id);
+                c_it->second->handle_msg(e_id, m_it);
             } catch(const exception& e) {
                 throw e;
-                break;
-            } catch(...) { break; }
-        }}  //  End double for
+            } catch(...) {}
+        }
     }
 }
 
 /*
  *
  */
-const message_container messages::get(const std::string& sys) {
+const message_container messages::get(const intern_id& sys) {
     message_container temp_messages;
-    for(auto it = _messages.begin(); it != _messages.end();) {
-        //  End early if events are in the future
-        if(it->get_timer() > engine_time::check()) break;
-        if((it->get_timer() == -1 || it->get_timer() == engine_time::check()) && it->get_sys() == sys) {
-            log(*it);
-            temp_messages.push_back(*it);  //  Add the message to the temp vector to be returned.
-            it = _messages.erase(it);  //  Erase the message once processed.
-        } else it++;  //  Message not processed, iterate to next.
+
+    auto u_it = _untimed.find(sys);
+    if(u_it != _untimed.end()) drain(u_it->second, temp_messages);
+
+    //  Only the bucket for the current tick needs checking.
+    auto t_it = _timed.find(engine_time::check());
+    if(t_it != _timed.end()) {
+        auto q_it = t_it->second.find(sys);
+        if(q_it != t_it->second.end()) drain(q_it->second, temp_messages);
     }
+
+    if constexpr (build_options.debug_mode)
+        for(auto& it: temp_messages) log(it);
     return temp_messages;
 }
 
+/*
+ *
+ */
+void messages::drain(std::vector<message>& queue, message_container& to) {
+    if(queue.empty()) return;
+    to.reserve(to.size() + queue.size());
+    for(auto& it: queue) to.push_back(std::move(it));
+    //  Keep the queue's storage for reuse.
+    queue.clear();
+}
+
+/*
+ *
+ */
+void messages::prune(void) {
+    //  Empty the untimed queues, keeping them for reuse.
+    for(auto& q_it: _untimed) {
+        if constexpr (build_options.debug_mode) {
+            for(auto& it: q_it.second) msg_trace::record(it, trace::EVENT_DELETED);
+        }
+        q_it.second.clear();
+    }
+
+    //  Remove all buckets up to and including the current tick.
+    const auto end = _timed.upper_bound(engine_time::check());
+    if constexpr (build_options.debug_mode) {
+        for(auto t_it = _timed.begin(); t_it != end; t_it++) {
+            for(auto& q_it: t_it->second) {
+                for(auto& it: q_it.second) msg_trace::record(it, trace::EVENT_DELETED);
+            }
+        }
+    }
+    _timed.erase(_timed.begin(), end);
+}
+
 /*
  *
  */
 void messages::load_file(const std::string& fname) {
-    _messages.clear();
+    clear();
     //  Open data file - read binary mode.
     ALLEGRO_FILE* file;
     file = al_fopen(fname.c_str(), "rb");
     //  File not found, error.
-    if(!file) {
-        al_fclose(file);
-        throw std::runtime_error("Error loading game data!");
-    }
-
-    //  Loop through the entire data file loading into the queue.
-    while(true) {
-        if(al_feof(file)) break;  //  End loop if eof.
-
-        int64_t timer = -1;
-        std::string sys, to, from, cmd, args;
+    if(!file) throw std::runtime_error("Error loading game data!");
 
-        //  Read the message from file.
-        read(*file, timer, sys, to, from, cmd, args);
-
-        //  Add message to queue.  Ignore incomplete messages.
-        if(sys != "" && cmd != "") _messages.push_back(message(timer, sys, to, from, cmd, args));
-    }
-    al_fclose(file);
-
-    //  Sort the queue so timed events are in order first to last.
-    std::sort(_messages.begin(), _messages.end());
+    if(!load(file, 0)) throw std::runtime_error("Error loading game data!");
 }
 
 /*
@@ -113,77 +241,213 @@ const bool messages::load_script(const std::string& fname) {
     ALLEGRO_FILE* file;
     file = al_fopen(fname.c_str(), "rb");
     //  File not found, error.
-    if(!file) {
+    if(!file) return false;
+
+    //  Add the current time to the timer values.
+    return load(file, engine_time::check());
+}
+
+/*
+ *
+ */
+const bool messages::load(ALLEGRO_FILE* file, const int64_t& offset) {
+    script_stream s;
+    s.file = file;
+    s.offset = offset;
+    s.batch_pos = 0;
+    s.next_record = 0;
+
+    //  Not an indexed script, read as a legacy data file.
+    if(
+        al_fread(file, &s.header, sizeof(script::header)) != sizeof(script::header) ||
+        !std::equal(s.header.magic, s.header.magic + 4, script::MAGIC)
+    ) {
+        al_fseek(file, 0, ALLEGRO_SEEK_SET);
+        read_legacy(file, offset);
+        al_fclose(file);
+        return true;
+    }
+
+    /*
+     * Check the header before trusting it.  The sections must be in order
+     * and fit in the file:  header, string table, records, payload.
+     */
+    const int64_t file_size = al_fsize(file);
+    const script::header& h = s.header;
+    const uint64_t string_table_end = h.string_offset + uint64_t(h.string_count) * sizeof(uint32_t);
+    if(
+        h.version != script::VERSION ||
+        file_size < 0 ||
+        h.string_offset < sizeof(script::header) ||
+        h.string_offset > h.record_offset ||
+        h.record_offset > h.payload_offset ||
+        h.payload_offset > uint64_t(file_size) ||
+        string_table_end > h.record_offset ||
+        h.record_offset + uint64_t(h.record_count) * sizeof(script::record) > h.payload_offset ||
+        h.payload_offset + uint64_t(h.payload_count) * sizeof(script::value) > uint64_t(file_size)
+    ) {
         al_fclose(file);
         return false;
     }
 
-    //  Loop through the entire data file loading into the queue.
-    while(true) {
-        if(al_feof(file)) break;  //  End loop if eof.
+    //  Load the string table.
+    std::vector<uint32_t> string_offsets(h.string_count);
+    const uint64_t strings_size = h.record_offset - string_table_end;
+    std::vector<char> string_data(strings_size + 1, '\0');
+    if(
+        !al_fseek(file, h.string_offset, ALLEGRO_SEEK_SET) ||
+        al_fread(file, string_offsets.data(), string_offsets.size() * sizeof(uint32_t)) !=
+            string_offsets.size() * sizeof(uint32_t) ||
+        al_fread(file, string_data.data(), strings_size) != strings_size
+    ) {
+        al_fclose(file);
+        return false;
+    }
 
-        int64_t timer = -1;
-        std::string sys, to, from, cmd, args;
+    s.strings.reserve(s.header.string_count);
+    for(auto& it: string_offsets) {
+        if(it < strings_size) s.strings.emplace_back(string_data.data() + it);
+        else s.strings.emplace_back("");
+    }
+    s.ids.assign(s.strings.size(), intern::EMPTY);
 
-        //  Read the message from file.
-        read(*file, timer, sys, to, from, cmd, args);
+    //  Keep the file open and read messages as they become due.
+    streams.push_back(std::move(s));
+    stream_scripts();
+    return true;
+}
+
+/*
+ *
+ */
+const bool messages::read_batch(script_stream& s) {
+    if(s.next_record >= s.header.record_count) return false;
 
-        //  Add the current time to the timer value.
-        if(timer != -1) timer += engine_time::check();
+    const uint32_t count = std::min(STREAM_BATCH, s.header.record_count - s.next_record);
+    s.records.resize(count);
+    al_fseek(s.file, s.header.record_offset + s.next_record * sizeof(script::record), ALLEGRO_SEEK_SET);
+    if(al_fread(s.file, s.records.data(), count * sizeof(script::record)) != count * sizeof(script::record))
+        return false;
+    s.next_record += count;
+    s.batch_pos = 0;
 
-        //  Add message to queue.  Ignore incomplete messages.  Sort while adding.
-        if(sys != "" && cmd != "") add(message(timer, sys, to, from, cmd, args));
+    //  Payload values are stored in record order, read the batch's range at once.
+    s.values.clear();
+    const uint32_t first = s.records.front().payload_start;
+    const uint32_t last = s.records.back().payload_start + s.records.back().payload_count;
+    if(last > first && last <= s.header.payload_count) {
+        s.values.resize(last - first);
+        al_fseek(s.file, s.header.payload_offset + first * sizeof(script::value), ALLEGRO_SEEK_SET);
+        if(al_fread(s.file, s.values.data(), s.values.size() * sizeof(script::value)) !=
+           s.values.size() * sizeof(script::value)) s.values.clear();
     }
-    al_fclose(file);
     return true;
 }
 
 /*
  *
  */
-void messages::read(
-    ALLEGRO_FILE& file,
-    int64_t& timer,
-    std::string& sys,
-    std::string& to,
-    std::string& from,
-    std::string& cmd,
-    std::string& args
-) {
-    //  Read in timer value.
-    al_fread(&file, &timer, sizeof(int64_t));
-
-    //  For each of the strings above, loop through and read
-    //  each charecter, ending if we reach null termed or eof.
-    while(true) {
-        const char ch = al_fgetc(&file);
-        if(ch == EOF) break;  //  End loop if eof.
-        if(ch == '\0') break;  //  End loop if null terminated.
-        sys += ch;
-    }
-    while(true) {
-        const char ch = al_fgetc(&file);
-        if(ch == EOF) break;  //  End loop if eof.
-        if(ch == '\0') break;  //  End loop if null terminated.
-        to += ch;
-    }
-    while(true) {
-        const char ch = al_fgetc(&file);
-        if(ch == EOF) break;  //  End loop if eof.
-        if(ch == '\0') break;  //  End loop if null terminated.
-        from += ch;
+void messages::stream_scripts(void) {
+    for(auto s_it = streams.begin(); s_it != streams.end();) {
+        script_stream& s = *s_it;
+        bool done = false;
+
+        while(true) {
+            if(s.batch_pos >= s.records.size() && !read_batch(s)) {
+                done = true;
+                break;
+            }
+
+            const script::record& rec = s.records[s.batch_pos];
+            const int64_t timer = (rec.timer == -1 ? -1 : rec.timer + s.offset);
+            if(timer > engine_time::check()) break;  //  Not due yet.
+            s.batch_pos++;
+
+            //  Intern strings the first time they are used.
+            auto lookup = [&s](const uint32_t& i) {
+                if(i >= s.strings.size()) return intern::EMPTY;
+                if(s.ids[i] == intern::EMPTY && !s.strings[i].empty()) s.ids[i] = intern::id(s.strings[i]);
+                return s.ids[i];
+            };
+            const intern_id sys = lookup(rec.sys);
+            const intern_id cmd = lookup(rec.cmd);
+            //  Ignore incomplete messages.
+            if(sys == intern::EMPTY || cmd == intern::EMPTY) continue;
+
+            auto text = [&s](const uint32_t& i) {
+                return (i < s.strings.size() ? s.strings[i] : std::string());
+            };
+            message msg(timer, sys, text(rec.to), text(rec.from), cmd, text(rec.args));
+
+            if(rec.payload_count > 0 && !s.values.empty()) {
+                msg_payload payload;
+                const uint32_t first = s.records.front().payload_start;
+                for(uint32_t i = rec.payload_start; i < rec.payload_start + rec.payload_count; i++) {
+                    if(i - first >= s.values.size()) break;
+                    const script::value& v = s.values[i - first];
+                    switch(v.type) {
+                        case script::VALUE_BOOL:  payload.push_back(v.int_value != 0); break;
+                        case script::VALUE_INT:   payload.push_back(v.int_value); break;
+                        case script::VALUE_FLOAT: payload.push_back(v.float_value); break;
+                        default:                  payload.push_back(std::monostate()); break;
+                    }
+                }
+                msg.set_payload(payload);
+            }
+            route(msg);
+        }
+
+        if(done) {
+            al_fclose(s.file);
+            s_it = streams.erase(s_it);
+        } else s_it++;
     }
-    while(true) {
-        const char ch = al_fgetc(&file);
-        if(ch == EOF) break;  //  End loop if eof.
-        if(ch == '\0') break;  //  End loop if null terminated.
-        cmd += ch;
+}
+
+/*
+ *
+ */
+void messages::read_legacy(ALLEGRO_FILE* file, const int64_t& offset) {
+    //  Read the whole file in one go.
+    std::vector<char> buffer;
+    const int64_t size = al_fsize(file);
+    if(size > 0) {
+        buffer.resize(size);
+        buffer.resize(al_fread(file, buffer.data(), size));
+    } else {
+        //  Size unknown, read in chunks.
+        char chunk[4096];
+        std::size_t read_size;
+        while((read_size = al_fread(file, chunk, sizeof(chunk))) > 0)
+            buffer.insert(buffer.end(), chunk, chunk + read_size);
     }
-    while(true) {
-        const char ch = al_fgetc(&file);
-        if(ch == EOF) break;  //  End loop if eof.
-        if(ch == '\0') break;  //  End loop if null terminated.
-        args += ch;
+
+    //  Read a null terminated string, ending early at the end of the buffer.
+    std::size_t pos = 0;
+    auto read_string = [&buffer, &pos]() {
+        const std::size_t start = pos;
+        while(pos < buffer.size() && buffer[pos] != '\0') pos++;
+        std::string result(buffer.data() + start, pos - start);
+        if(pos < buffer.size()) pos++;  //  Skip the terminator.
+        return result;
+    };
+
+    while(pos + sizeof(int64_t) <= buffer.size()) {
+        int64_t timer;
+        std::memcpy(&timer, buffer.data() + pos, sizeof(int64_t));
+        pos += sizeof(int64_t);
+
+        const std::string sys = read_string();
+        const std::string to = read_string();
+        const std::string from = read_string();
+        const std::string cmd = read_string();
+        const std::string args = read_string();
+
+        //  Add the offset to the timer value.
+        if(timer != -1) timer += offset;
+
+        //  Add message to queue.  Ignore incomplete messages.
+        if(sys != "" && cmd != "") route(message(timer, sys, to, from, cmd, args));
     }
 }
 
@@ -24,24 +24,51 @@ time_point<system_clock> renderer::_last_render;
 time_point<system_clock> renderer::_start_time;
 duration renderer::_delta_time;
 bool renderer::arena_created = false;
+std::vector<renderer::viewport> renderer::viewports;
+float renderer::view_x = 0.0f, renderer::view_y = 0.0f;
+float renderer::view_w = 0.0f, renderer::view_h = 0.0f;
+std::size_t renderer::_drawn = 0, renderer::_culled = 0;
+std::vector<renderer::layer_cache> renderer::layer_caches;
+renderer::draw_list renderer::last_backgrounds;
+std::vector<std::size_t> renderer::last_revisions;
+renderer::snapshot renderer::snapshots[3];
+std::size_t renderer::back = 0, renderer::ready = 1, renderer::front = 2;
+bool renderer::fresh = false;
+std::atomic<bool> renderer::thread_running = false;
+std::thread renderer::render_thread;
+std::mutex renderer::snapshot_mtx;
+std::mutex renderer::display_mtx;
+std::atomic<std::thread::id> renderer::display_owner;
+std::condition_variable renderer::snapshot_cv;
+ALLEGRO_DISPLAY* renderer::render_display = NULL;
 std::string renderer::title_screen_file;
 std::string renderer::background_file;
+renderer::render_list<cmp::gfx::background> renderer::backgrounds;
+renderer::render_list<cmp::gfx::sprite> renderer::sprites;
+renderer::render_list<cmp::gfx::overlay> renderer::overlays;
+std::vector<component_change> renderer::changes;
+std::unordered_set<const cmp::component*> renderer::removed;
 
 const std::size_t& renderer::fps = renderer::_fps;
 const time_point<system_clock>& renderer::last_render = renderer::_last_render;
 const time_point<system_clock>& renderer::start_time = renderer::_start_time;
 const duration& renderer::delta_time = renderer::_delta_time;
+const std::size_t& renderer::drawn = renderer::_drawn;
+const std::size_t& renderer::culled = renderer::_culled;
 
 /*
  *
  */
 void renderer::initialize(void) {
+    render_display = al_get_current_display();
+
     //  Create the arena bitmap.
     if(config::gfx::arena_w == 0 || config::gfx::arena_h == 0) throw std::runtime_error("Arena size not defined!");
     arena_bitmap = make_asset(al_bitmap(config::gfx::arena_w, config::gfx::arena_h, true));
     //  Add reference to Asset manager so bitmap can be reloaded.
     mgr::assets<al_bitmap>::load<al_bitmap>("wte_renderer_arena_bitmap", arena_bitmap);
     arena_created = true;
+    clear_viewports();
 
     //  Set the overlay's font to the system default.
     renderer_font = mgr::assets<al_font>::get<al_font>("wte_default_font");
@@ -69,6 +96,12 @@ void renderer::initialize(void) {
  *
  */
 void renderer::de_init(void) {
+    for(auto& it: layer_caches) al_destroy_bitmap(it.bitmap);
+    layer_caches.clear();
+    for(auto& snap: snapshots) {
+        for(auto& it: snap.copies) al_destroy_bitmap(it.bitmap);
+        snap.copies.clear();
+    }
     al_destroy_event_queue(fps_event_queue);
     al_destroy_timer(fps_timer);
 }
@@ -84,6 +117,58 @@ void renderer::set_arena_size(const int& w, const int& h) {
     }
 }
 
+/*
+ *
+ */
+const std::size_t renderer::add_viewport(
+    const float& x, const float& y, const float& w, const float& h
+) {
+    assert(w > 0 && h > 0);
+    viewports.push_back({ x, y, w, h, 0.0f, 0.0f, 1.0f });
+    return viewports.size() - 1;
+}
+
+/*
+ *
+ */
+void renderer::set_viewport(
+    const std::size_t& vp, const float& x, const float& y, const float& w, const float& h
+) {
+    assert(w > 0 && h > 0);
+    if(vp >= viewports.size()) throw exception(
+        exception_item("Viewport " + std::to_string(vp) + " does not exist", "Renderer", 4));
+    viewports[vp].x = x;
+    viewports[vp].y = y;
+    viewports[vp].w = w;
+    viewports[vp].h = h;
+}
+
+/*
+ *
+ */
+void renderer::set_camera(
+    const float& x, const float& y, const float& zoom, const std::size_t& vp
+) {
+    assert(zoom > 0);
+    if(vp >= viewports.size()) throw exception(
+        exception_item("Viewport " + std::to_string(vp) + " does not exist", "Renderer", 4));
+    viewports[vp].cam_x = x;
+    viewports[vp].cam_y = y;
+    viewports[vp].zoom = zoom;
+}
+
+/*
+ *
+ */
+void renderer::clear_viewports(void) {
+    viewports.clear();
+    viewports.push_back({
+        0.0f, 0.0f,
+        static_cast<float>(config::gfx::arena_w), static_cast<float>(config::gfx::arena_h),
+        0.0f, 0.0f, 1.0f
+    });
+}
+
 /*
  *
  */
@@ -98,6 +183,14 @@ void renderer::set_font(wte_asset<al_font> font) { renderer_font = font; }
  *
  */
 void renderer::render(void) {
+    //  With the render thread, wait for the last snapshot to be drawn before taking another.
+    if constexpr (build_options.render_thread) {
+        snapshot_mtx.lock();
+        const bool waiting = fresh;
+        snapshot_mtx.unlock();
+        if(waiting) return;
+    }
+
     /*
      * Calculate fps.
      */
@@ -113,185 +206,227 @@ void renderer::render(void) {
     //  Toggle no preserve texture for faster rendering.
     al_set_new_bitmap_flags(ALLEGRO_NO_PRESERVE_TEXTURE);
 
-    //  Set drawing to the screen.
-    al_set_target_backbuffer(al_get_current_display());
-    al_clear_to_color(WTE_COLOR_BLACK);
+    if constexpr (build_options.render_thread) {
+        //  Copying bitmaps and letting go of removed components needs the display.
+        hold_display();
+        take_snapshot(snapshots[back]);
+        release_display();
+
+        //  Hand the snapshot to the render thread.
+        snapshot_mtx.lock();
+        std::swap(back, ready);
+        fresh = true;
+        snapshot_mtx.unlock();
+        snapshot_cv.notify_one();
+    } else {
+        take_snapshot(snapshots[back]);
+        draw_frame(snapshots[back]);
+    }
 
-    //  Render world if the game is running.
-    if(config::flags::game_started) {
-        //  Set drawing to the arena bitmap.
-        al_set_target_bitmap(**arena_bitmap);
-        al_clear_to_color(WTE_COLOR_BLACK);
+    //  Update delta time.
+    _delta_time = system_clock::now() - _last_render;
+    _last_render = system_clock::now();
+}
 
-        //  Draw the backgrounds.
-        const const_component_container<cmp::gfx::background> background_components =
-            mgr::world::get_components<cmp::gfx::background>();
-
-        //  Sort the background layers.
-        std::multiset<entity_component_pair<cmp::gfx::background>,
-            comparator<entity_component_pair<cmp::gfx::background>>> background_componenet_set(
-            background_components.begin(), background_components.end());
-
-        //  Draw each background by layer.
-        for(auto& it: background_componenet_set) {
-            if(it.second->visible) {
-                float angle = 0.0f;
-                float center_x = 0.0f, center_y = 0.0f;
-                float destination_x = 0.0f, destination_y = 0.0f;
-
-                if(it.second->rotated) {
-                    angle = it.second->direction;
-                    center_x = (al_get_bitmap_width(**it.second->_bitmap) / 2);
-                    center_y = (al_get_bitmap_height(**it.second->_bitmap) / 2);
-
-                    destination_x = it.second->pos_x +
-                        (al_get_bitmap_width(**it.second->_bitmap) * it.second->scale_factor_x / 2);
-                    destination_y = it.second->pos_y +
-                        (al_get_bitmap_height(**it.second->_bitmap) * it.second->scale_factor_y / 2);
-                } else {
-                        destination_x = it.second->pos_x;
-                        destination_y = it.second->pos_y;
-                }
-
-                if(it.second->tinted)
-                    al_draw_tinted_scaled_rotated_bitmap(
-                        **it.second->_bitmap, it.second->get_tint(),
-                        center_x, center_y, destination_x, destination_y,
-                        it.second->scale_factor_x,
-                        it.second->scale_factor_y,
-                        angle, 0
-                    );
-                else
-                    al_draw_scaled_rotated_bitmap(
-                        **it.second->_bitmap,
-                        center_x, center_y, destination_x, destination_y,
-                        it.second->scale_factor_x,
-                        it.second->scale_factor_y,
-                        angle, 0
-                    );
-            }
-        }
+/*
+ *
+ */
+void renderer::take_snapshot(snapshot& snap) {
+    snap.game_started = config::flags::game_started;
+    snap.draw_fps = config::flags::draw_fps;
+    snap.fps = _fps;
+    snap.timer = engine_time::check();
+    snap.backgrounds.clear();
+    snap.background_revisions.clear();
+    snap.overlays.clear();
+    snap.hitboxes.clear();
+    snap.copies_used = 0;
+
+    if(!snap.game_started) {
+        release_copies(snap);
+        return;
+    }
 
-        //  Draw the sprites.
-        const const_component_container<cmp::gfx::sprite> sprite_components =
-            mgr::world::get_components<cmp::gfx::sprite>();
-
-        //  Sort the sprite components.
-        std::multiset<entity_component_pair<cmp::gfx::sprite>,
-            comparator<entity_component_pair<cmp::gfx::sprite>>> sprite_componenet_set(
-            sprite_components.begin(), sprite_components.end());
-
-        //  Draw each sprite in order.
-        for(auto& it: sprite_componenet_set) {
-            if(it.second->visible) {
-                //  Get the current sprite frame.
-                ALLEGRO_BITMAP* temp_bitmap = al_create_sub_bitmap(
-                    **it.second->_bitmap,
-                    it.second->sprite_x,
-                    it.second->sprite_y,
-                    it.second->sprite_width,
-                    it.second->sprite_height
-                );
+    //  Bring the render lists up to date with the world.
+    update_lists();
 
+    //  Backgrounds and overlays are culled against the arena.
+    view_x = 0.0f;
+    view_y = 0.0f;
+    view_w = config::gfx::arena_w;
+    view_h = config::gfx::arena_h;
+    _drawn = _culled = 0;
+
+    for(auto& it: backgrounds) {
+        if(it.comp->visible) {
+            queue_bitmap(snap, snap.backgrounds, it.comp);
+            snap.background_revisions.resize(snap.backgrounds.size(), it.comp->revision);
+        }
+    }
+    for(auto& it: overlays)
+        if(it.comp->visible) queue_bitmap(snap, snap.overlays, it.comp);
+
+    //  Queue the sprites seen by each viewport's camera.
+    snap.views.resize(viewports.size());
+    for(std::size_t i = 0; i < viewports.size(); i++) {
+        const viewport& vp = viewports[i];
+        snap.views[i].vp = vp;
+        draw_list& sprite_draws = snap.views[i].sprites;
+        sprite_draws.clear();
+        sprite_draws.reserve(sprites.size());
+
+        //  Cull against the part of the world the camera sees.
+        view_x = vp.cam_x;
+        view_y = vp.cam_y;
+        view_w = vp.w / vp.zoom;
+        view_h = vp.h / vp.zoom;
+
+        for(auto& it: sprites) {
+            if(it.comp->visible) {
                 try {
-                    float angle = 0.0f;
-                    float center_x = 0.0f, center_y = 0.0f;
-                    float destination_x = 0.0f, destination_y = 0.0f;
-                    cmp::const_comp_ptr<cmp::location> temp_get = mgr::world::get_component<cmp::location>(it.first);
+                    draw_item item;
+                    item.layer = it.layer;
+                    item.bitmap = **it.comp->_bitmap;
+                    item.source = item.bitmap;
+                    item.texture = it.texture;
+                    item.sx = it.comp->sprite_x;
+                    item.sy = it.comp->sprite_y;
+                    item.sw = static_cast<int>(it.comp->sprite_width);
+                    item.sh = static_cast<int>(it.comp->sprite_height);
+                    item.tint = (it.comp->tinted ? it.comp->get_tint() : al_map_rgba_f(1.0f, 1.0f, 1.0f, 1.0f));
+                    item.xscale = it.comp->scale_factor_x;
+                    item.yscale = it.comp->scale_factor_y;
+                    item.angle = 0.0f;
+                    item.cx = 0.0f;
+                    item.cy = 0.0f;
+                    cmp::const_comp_ptr<cmp::location> temp_get = mgr::world::get_component<cmp::location>(it.e_id);
 
                     //  Check if the sprite should be rotated.
-                    if(it.second->rotated) {
-                        angle = it.second->direction;
-                        center_x = (al_get_bitmap_width(temp_bitmap) / 2);
-                        center_y = (al_get_bitmap_height(temp_bitmap) / 2);
-
-                        destination_x = temp_get->pos_x +
-                            (al_get_bitmap_width(temp_bitmap) * it.second->scale_factor_x / 2) +
-                            (it.second->draw_offset_x * it.second->scale_factor_x);
-                        destination_y = temp_get->pos_y +
-                            (al_get_bitmap_height(temp_bitmap) * it.second->scale_factor_y / 2) +
-                            (it.second->draw_offset_y * it.second->scale_factor_y);
+                    if(it.comp->rotated) {
+                        item.angle = it.comp->direction;
+                        item.cx = (static_cast<int>(item.sw) / 2);
+                        item.cy = (static_cast<int>(item.sh) / 2);
+
+                        item.dx = temp_get->pos_x +
+                            (item.sw * it.comp->scale_factor_x / 2) +
+                            (it.comp->draw_offset_x * it.comp->scale_factor_x);
+                        item.dy = temp_get->pos_y +
+                            (item.sh * it.comp->scale_factor_y / 2) +
+                            (it.comp->draw_offset_y * it.comp->scale_factor_y);
                     } else {
-                            destination_x = temp_get->pos_x + it.second->draw_offset_x;
-                            destination_y = temp_get->pos_y + it.second->draw_offset_y;
+                            item.dx = temp_get->pos_x + it.comp->draw_offset_x;
+                            item.dy = temp_get->pos_y + it.comp->draw_offset_y;
                     }
 
-                    //  Draw the sprite.
-                    if(it.second->tinted)
-                        al_draw_tinted_scaled_rotated_bitmap(
-                            temp_bitmap, it.second->get_tint(),
-                            center_x, center_y, destination_x, destination_y,
-                            it.second->scale_factor_x,
-                            it.second->scale_factor_y,
-                            angle, 0
-                        );
-                    else
-                        al_draw_scaled_rotated_bitmap(
-                            temp_bitmap, center_x, center_y, destination_x, destination_y,
-                            it.second->scale_factor_x,
-                            it.second->scale_factor_y,
-                            angle, 0
-                        );
-                } catch(...) { throw; }
+                    //  Skip sprites outside the view.
+                    const float draw_w = item.sw * item.xscale, draw_h = item.sh * item.yscale;
+                    if(!in_view(
+                        (it.comp->rotated ? item.dx - draw_w / 2 : item.dx),
+                        (it.comp->rotated ? item.dy - draw_h / 2 : item.dy),
+                        draw_w, draw_h, it.comp->rotated)) continue;
 
-                al_destroy_bitmap(temp_bitmap);
+                    item.bitmap = snapshot_bitmap(snap, it.comp->_bitmap, it.comp->revision);
+                    sprite_draws.push_back(item);
+                } catch(...) { throw; }
             }
         }
+    }
 
-        //  Draw hitboxes if debug is enabled.
-        if(build_options.debug_mode && config::flags::show_hitboxes) draw_hitboxes();
-
-        //  Draw the overlays.
-        const const_component_container<cmp::gfx::overlay> overlay_components =
-            mgr::world::get_components<cmp::gfx::overlay>();
-
-        //  Sort the overlay layers.
-        std::multiset<entity_component_pair<cmp::gfx::overlay>,
-            comparator<entity_component_pair<cmp::gfx::overlay>>> overlay_componenet_set(
-            overlay_components.begin(), overlay_components.end());
-
-        //  Draw each overlay by layer.
-        for(auto& it: overlay_componenet_set) {
-            if(it.second->visible) {
-                float angle = 0.0f;
-                float center_x = 0.0f, center_y = 0.0f;
-                float destination_x = 0.0f, destination_y = 0.0f;
-
-                if(it.second->rotated) {
-                    angle = it.second->direction;
-                    center_x = (al_get_bitmap_width(**it.second->_bitmap) / 2);
-                    center_y = (al_get_bitmap_height(**it.second->_bitmap) / 2);
-
-                    destination_x = it.second->pos_x +
-                        (al_get_bitmap_width(**it.second->_bitmap) * it.second->scale_factor_x / 2);
-                    destination_y = it.second->pos_y +
-                        (al_get_bitmap_height(**it.second->_bitmap) * it.second->scale_factor_y / 2);
-                } else {
-                        destination_x = it.second->pos_x;
-                        destination_y = it.second->pos_y;
-                }
-
-                if(it.second->tinted)
-                    al_draw_tinted_scaled_rotated_bitmap(
-                        **it.second->_bitmap, it.second->get_tint(),
-                        center_x, center_y, destination_x, destination_y,
-                        it.second->scale_factor_x,
-                        it.second->scale_factor_y,
-                        angle, 0
-                    );
-                else
-                    al_draw_scaled_rotated_bitmap(
-                        **it.second->_bitmap,
-                        center_x, center_y, destination_x, destination_y,
-                        it.second->scale_factor_x,
-                        it.second->scale_factor_y,
-                        angle, 0
-                    );
-            }
+    //  Record hitboxes if debug is enabled.
+    if(build_options.debug_mode && config::flags::show_hitboxes) take_hitboxes(snap.hitboxes);
+
+    release_copies(snap);
+}
+
+/*
+ *
+ */
+ALLEGRO_BITMAP* renderer::snapshot_bitmap(
+    snapshot& snap, const wte_asset<al_bitmap>& bmp, const std::size_t& revision
+) {
+    //  Drawn right away, or never drawn to, so the bitmap can be used as is.
+    if(!build_options.render_thread || revision == 0) return **bmp;
+
+    if(snap.copies_used == snap.copies.size()) snap.copies.push_back({ nullptr, 0, NULL });
+    bitmap_copy& copy = snap.copies[snap.copies_used];
+    snap.copies_used++;
+
+    //  Copies are used in the same order each frame, so most are still current.
+    if(copy.source == bmp && copy.revision == revision) return copy.bitmap;
+
+    const int w = al_get_bitmap_width(**bmp);
+    const int h = al_get_bitmap_height(**bmp);
+    if(copy.bitmap == NULL || al_get_bitmap_width(copy.bitmap) != w || al_get_bitmap_height(copy.bitmap) != h) {
+        if(copy.bitmap != NULL) al_destroy_bitmap(copy.bitmap);
+        copy.bitmap = al_create_bitmap(w, h);
+    }
+
+    //  Replace the copy's pixels, alpha included.
+    ALLEGRO_STATE state;
+    al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+    al_set_target_bitmap(copy.bitmap);
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    al_draw_bitmap(**bmp, 0, 0, 0);
+    al_restore_state(&state);
+
+    copy.source = bmp;
+    copy.revision = revision;
+    return copy.bitmap;
+}
+
+/*
+ *
+ */
+void renderer::release_copies(snapshot& snap) {
+    //  The copy bitmaps are kept for reuse.
+    for(std::size_t i = snap.copies_used; i < snap.copies.size(); i++) snap.copies[i].source.reset();
+}
+
+/*
+ *
+ */
+void renderer::draw_frame(const snapshot& snap) {
+    //  Set drawing to the screen.
+    al_set_target_backbuffer(render_display);
+    al_clear_to_color(WTE_COLOR_BLACK);
+
+    //  Render world if the game is running.
+    if(snap.game_started) {
+        //  Set drawing to the arena bitmap.
+        al_set_target_bitmap(**arena_bitmap);
+        al_clear_to_color(WTE_COLOR_BLACK);
+
+        //  Draw the backgrounds by layer.
+        draw_backgrounds(snap);
+
+        //  Draw the sprites through each viewport's camera.
+        for(auto& it: snap.views) {
+            ALLEGRO_TRANSFORM camera;
+            al_identity_transform(&camera);
+            al_translate_transform(&camera, -it.vp.cam_x, -it.vp.cam_y);
+            al_scale_transform(&camera, it.vp.zoom, it.vp.zoom);
+            al_translate_transform(&camera, it.vp.x, it.vp.y);
+            al_use_transform(&camera);
+            al_set_clipping_rectangle(it.vp.x, it.vp.y, it.vp.w, it.vp.h);
+
+            //  Draw the sprites, batched by layer and sprite sheet.
+            draw(it.sprites);
+
+            //  Draw hitboxes if debug is enabled.
+            draw_hitboxes(snap.hitboxes);
         }
 
+        //  Back to arena coordinates.
+        ALLEGRO_TRANSFORM identity;
+        al_identity_transform(&identity);
+        al_use_transform(&identity);
+        al_reset_clipping_rectangle();
+
+        //  Draw the overlays by layer.
+        draw(snap.overlays);
+
         //  Draw the arena bitmap to the screen.
-        al_set_target_backbuffer(al_get_current_display());
+        al_set_target_backbuffer(render_display);
         al_draw_scaled_bitmap(
             **arena_bitmap, 0, 0, config::gfx::arena_w, config::gfx::arena_h,
             (config::gfx::screen_w / 2) - (config::gfx::arena_w * config::gfx::scale_factor / 2),
@@ -306,16 +441,228 @@ void renderer::render(void) {
     }
 
     //  Draw frame rate.
-    if(config::flags::draw_fps) {
-        const std::string fps_string = "FPS: " + std::to_string(fps);
+    if(snap.draw_fps) {
+        const std::string fps_string = "FPS: " + std::to_string(snap.fps);
         al_draw_text(**renderer_font, WTE_COLOR_YELLOW, config::gfx::screen_w, 1, ALLEGRO_ALIGN_RIGHT, fps_string.c_str());
     }
-    draw_timer();
+    //  Draw time if debug mode is enabled.
+    if constexpr (build_options.debug_mode) {
+        const std::string timer_string = "Timer: " + std::to_string(snap.timer);
+        al_draw_text(**renderer_font, WTE_COLOR_YELLOW, config::gfx::screen_w, 10, ALLEGRO_ALIGN_RIGHT, timer_string.c_str());
+    }
 
-    //  Update the screen & delta time.
+    //  Update the screen.
     al_flip_display();
-    _delta_time = system_clock::now() - _last_render;
-    _last_render = system_clock::now();
+}
+
+/*
+ *
+ */
+void renderer::start_thread(void) {
+    if constexpr (build_options.render_thread) {
+        if(thread_running) return;
+        //  Let go of the display so the render thread can take it.
+        al_set_target_bitmap(NULL);
+        back = 0;
+        ready = 1;
+        front = 2;
+        fresh = false;
+        thread_running = true;
+        render_thread = std::thread(&renderer::run);
+    }
+}
+
+/*
+ *
+ */
+void renderer::stop_thread(void) {
+    if constexpr (build_options.render_thread) {
+        if(!thread_running) return;
+        snapshot_mtx.lock();
+        thread_running = false;
+        snapshot_mtx.unlock();
+        snapshot_cv.notify_one();
+        if(render_thread.joinable()) render_thread.join();
+        //  The main thread has the display again.
+        al_set_target_backbuffer(render_display);
+    }
+}
+
+/*
+ *
+ */
+void renderer::run(void) {
+    while(true) {
+        std::unique_lock<std::mutex> lock(snapshot_mtx);
+        snapshot_cv.wait(lock, []{ return fresh || !thread_running; });
+        if(!thread_running) break;
+        //  Snapshots own what they draw, so a waiting snapshot is always good to draw.
+        std::swap(ready, front);
+        fresh = false;
+        lock.unlock();
+
+        display_mtx.lock();
+        al_set_target_backbuffer(render_display);
+        draw_frame(snapshots[front]);
+        al_set_target_bitmap(NULL);
+        display_mtx.unlock();
+    }
+}
+
+/*
+ *
+ */
+void renderer::hold_display(void) {
+    if constexpr (build_options.render_thread) {
+        display_mtx.lock();
+        display_owner = std::this_thread::get_id();
+        al_set_target_backbuffer(render_display);
+    }
+}
+
+/*
+ *
+ */
+void renderer::release_display(void) {
+    if constexpr (build_options.render_thread) {
+        al_set_target_bitmap(NULL);
+        display_owner = std::thread::id();
+        display_mtx.unlock();
+    }
+}
+
+/*
+ *
+ */
+const bool renderer::holding_display(void) {
+    if constexpr (build_options.render_thread) {
+        if(!thread_running) return true;
+        return display_owner == std::this_thread::get_id();
+    } else return true;
+}
+
+/*
+ *
+ */
+void renderer::draw(draw_list::const_iterator first, draw_list::const_iterator last) {
+    //  Allegro batches held draws until the texture changes.
+    al_hold_bitmap_drawing(true);
+    for(auto it = first; it != last; it++) {
+        al_draw_tinted_scaled_rotated_bitmap_region(
+            it->bitmap, it->sx, it->sy, it->sw, it->sh, it->tint,
+            it->cx, it->cy, it->dx, it->dy, it->xscale, it->yscale, it->angle, 0);
+    }
+    al_hold_bitmap_drawing(false);
+}
+
+/*
+ *
+ */
+void renderer::draw_backgrounds(const snapshot& snap) {
+    const draw_list& items = snap.backgrounds;
+    const std::vector<std::size_t>& revisions = snap.background_revisions;
+
+    //  A background is static if it is drawn the same as last frame.
+    auto is_static = [&items, &revisions](const std::size_t& i) {
+        return i < last_backgrounds.size() &&
+            revisions[i] == last_revisions[i] && same_draw(items[i], last_backgrounds[i]);
+    };
+
+    std::size_t cache_pos = 0;
+    std::size_t i = 0;
+    while(i < items.size()) {
+        const bool run_static = is_static(i);
+        std::size_t end = i + 1;
+        while(end < items.size() && is_static(end) == run_static) end++;
+
+        //  Changing backgrounds, or a single one, are drawn as is.
+        if(!run_static || end - i < 2) {
+            draw(items.begin() + i, items.begin() + end);
+            i = end;
+            continue;
+        }
+
+        if(cache_pos == layer_caches.size()) {
+            //  Cached layers keep their contents if the display is lost.
+            ALLEGRO_STATE cache_state;
+            al_store_state(&cache_state, ALLEGRO_STATE_NEW_BITMAP_PARAMETERS);
+            al_set_new_bitmap_flags(ALLEGRO_VIDEO_BITMAP);
+            layer_caches.push_back({ al_create_bitmap(config::gfx::arena_w, config::gfx::arena_h), {}, {} });
+            al_restore_state(&cache_state);
+        }
+        layer_cache& cache = layer_caches[cache_pos];
+        cache_pos++;
+
+        //  Redraw the cached layer if it was made from other backgrounds.
+        bool matches = (cache.items.size() == end - i);
+        for(std::size_t j = 0; matches && j < end - i; j++)
+            matches = (cache.revisions[j] == revisions[i + j] && same_draw(cache.items[j], items[i + j]));
+        if(!matches) {
+            ALLEGRO_BITMAP* target = al_get_target_bitmap();
+            al_set_target_bitmap(cache.bitmap);
+            al_clear_to_color(WTE_COLOR_TRANSPARENT);
+            draw(items.begin() + i, items.begin() + end);
+            al_set_target_bitmap(target);
+            cache.items.assign(items.begin() + i, items.begin() + end);
+            cache.revisions.assign(revisions.begin() + i, revisions.begin() + end);
+        }
+
+        al_draw_bitmap(cache.bitmap, 0, 0, 0);
+        i = end;
+    }
+
+    last_backgrounds.assign(items.begin(), items.end());
+    last_revisions.assign(revisions.begin(), revisions.end());
+}
+
+/*
+ *
+ */
+void renderer::update_lists(void) {
+    bool bg_changed = false, sprite_changed = false, overlay_changed = false;
+
+    if(mgr::world::take_changes(changes)) {
+        //  Changes were not all recorded, read the world again.
+        rebuild_list(backgrounds, false);
+        rebuild_list(sprites, true);
+        rebuild_list(overlays, false);
+        //  Anything logged since is already in the lists.
+        mgr::world::take_changes(changes);
+        changes.clear();
+        bg_changed = sprite_changed = overlay_changed = true;
+    }
+
+    removed.clear();
+    for(auto& it: changes) {
+        if(!it.added) {
+            removed.insert(it.comp.get());
+            continue;
+        }
+        //  Removed then added back, such as a pooled entity, is still in its list.
+        if(removed.erase(it.comp.get()) > 0) continue;
+        if(auto bg = std::dynamic_pointer_cast<const cmp::gfx::background>(it.comp)) {
+            add_item(backgrounds, it.e_id, bg, false);
+            bg_changed = true;
+        } else if(auto sprite = std::dynamic_pointer_cast<const cmp::gfx::sprite>(it.comp)) {
+            add_item(sprites, it.e_id, sprite, true);
+            sprite_changed = true;
+        } else if(auto overlay = std::dynamic_pointer_cast<const cmp::gfx::overlay>(it.comp)) {
+            add_item(overlays, it.e_id, overlay, false);
+            overlay_changed = true;
+        }
+    }
+    changes.clear();
+
+    //  Removing keeps the lists in order.
+    if(!removed.empty()) {
+        remove_items(backgrounds);
+        remove_items(sprites);
+        remove_items(overlays);
+    }
+
+    refresh_list(backgrounds, bg_changed, false);
+    refresh_list(sprites, sprite_changed, true);
+    refresh_list(overlays, overlay_changed, false);
 }
 
 }  //  namespace wte::mgr
@@ -17,9 +17,13 @@ std::map<
     const std::string,
     std::pair<
         const std::size_t,
-        const std::function<void(const entity_id&, const msg_args&)>
+        const std::function<void(const entity_id&, const message&)>
 >> spawner::spawns;
 
+std::map<const std::string, std::pair<const std::size_t, const prefab>> spawner::prefabs;
+std::unordered_map<entity_id, spawner::pool_item> spawner::pool_items;
+std::map<const std::string, std::vector<entity_id>> spawner::pools;
+
 /*
  *
  */
@@ -28,10 +32,37 @@ const bool spawner::add(
     const std::size_t& num_args,
     const std::function<void(const entity_id&, const msg_args&)>& func
 ) {
+    return add(name, num_args, [func](const entity_id& e_id, const message& msg) {
+        func(e_id, msg.get_args());
+    });
+}
+
+/*
+ *
+ */
+const bool spawner::add(
+    const std::string& name,
+    const std::size_t& num_args,
+    const std::function<void(const entity_id&, const message&)>& func
+) {
+    if(prefabs.find(name) != prefabs.end()) return false;
     auto ret = spawns.insert(std::make_pair(name, std::make_pair(num_args, func)));
     return ret.second;
 }
 
+/*
+ *
+ */
+const bool spawner::add(
+    const std::string& name,
+    const std::size_t& num_args,
+    const prefab& pre
+) {
+    if(spawns.find(name) != spawns.end()) return false;
+    auto ret = prefabs.insert(std::make_pair(name, std::make_pair(num_args, pre)));
+    return ret.second;
+}
+
 /*
  *
  */
@@ -42,7 +73,117 @@ const bool spawner::remove(const std::string& name) {
         spawns.erase(it);
         return true;
     }
-    return false;
+    if(prefabs.erase(name) == 0) return false;
+
+    //  Delete any pooled entities kept for the prefab.
+    auto p_it = pools.find(name);
+    if(p_it != pools.end()) {
+        const std::vector<entity_id> pooled = std::move(p_it->second);
+        pools.erase(p_it);
+        for(auto& e_id: pooled) mgr::world::delete_entity(e_id);
+    }
+    return true;
+}
+
+/*
+ *
+ */
+void spawner::clear(void) {
+    pool_items.clear();
+    pools.clear();
+}
+
+/*
+ *
+ */
+void spawner::spawn_prefab(
+    const std::string& name, const prefab& pre,
+    const std::size_t& count, const message& msg
+) {
+    std::vector<entity_id> spawned;
+    spawned.reserve(count);
+
+    //  Reuse pooled entities first, rebuilding their components in place.
+    auto pool_it = pools.find(name);
+    if(pool_it != pools.end()) {
+        auto& pool = pool_it->second;
+        while(spawned.size() < count && !pool.empty()) {
+            const entity_id e_id = pool.back();
+            pool.pop_back();
+            auto i_it = pool_items.find(e_id);
+            if(i_it == pool_items.end()) continue;
+            if(!mgr::world::activate_entity(e_id)) {
+                //  Entity was removed from the world, forget it.
+                pool_items.erase(i_it);
+                continue;
+            }
+            for(std::size_t i = 0; i < pre.resetters.size() && i < i_it->second.comps.size(); i++)
+                pre.resetters[i](i_it->second.comps[i].get());
+            spawned.push_back(e_id);
+        }
+    }
+
+    //  Create the rest, all entities then all their components, each in one step.
+    const std::size_t reused = spawned.size();
+    const std::vector<entity_id> new_ids = mgr::world::new_entities(count - reused);
+
+    std::vector<std::pair<entity_id, cmp::component_sptr>> comps;
+    comps.reserve(new_ids.size() * pre.factories.size());
+    for(auto& e_id: new_ids)
+        for(auto& f_it: pre.factories) comps.push_back(std::make_pair(e_id, f_it()));
+    mgr::world::add_components(comps);
+
+    //  Track new entities from pooled prefabs so they can be reused.
+    if(pre.pool_size > 0) {
+        for(std::size_t i = 0; i < new_ids.size(); i++) {
+            pool_item item;
+            item.prefab = name;
+            item.comps.reserve(pre.factories.size());
+            for(std::size_t j = 0; j < pre.factories.size(); j++)
+                item.comps.push_back(comps[i * pre.factories.size() + j].second);
+            pool_items.insert_or_assign(new_ids[i], std::move(item));
+        }
+    }
+    spawned.insert(spawned.end(), new_ids.begin(), new_ids.end());
+
+    if(pre.init) {
+        for(std::size_t i = 0; i < spawned.size(); i++) {
+            try {
+                pre.init(spawned[i], msg, i);
+            } catch(const exception& e) { throw e; }
+        }
+    }
+}
+
+/*
+ *
+ */
+void spawner::despawn(const entity_id& e_id) {
+    auto i_it = pool_items.find(e_id);
+    if(i_it != pool_items.end()) {
+        auto p_it = prefabs.find(i_it->second.prefab);
+        auto& pool = pools[i_it->second.prefab];
+        //  Keep the entity if its prefab still exists and the pool has room.
+        if(p_it != prefabs.end() && pool.size() < p_it->second.second.pool_size) {
+            if(mgr::world::deactivate_entity(e_id)) pool.push_back(e_id);
+            return;
+        }
+    }
+    mgr::world::delete_entity(e_id);
+}
+
+/*
+ *
+ */
+void spawner::forget(const entity_id& e_id) {
+    auto i_it = pool_items.find(e_id);
+    if(i_it == pool_items.end()) return;
+    auto p_it = pools.find(i_it->second.prefab);
+    if(p_it != pools.end()) {
+        auto& pool = p_it->second;
+        pool.erase(std::remove(pool.begin(), pool.end(), e_id), pool.end());
+    }
+    pool_items.erase(i_it);
 }
 
 /*
@@ -50,7 +191,7 @@ const bool spawner::remove(const std::string& name) {
  */
 void spawner::process_messages(const message_container& messages) {
     for(auto& m_it: messages) {
-        if(m_it.get_cmd() == "new") {
+        if(m_it.get_cmd_id() == CMD_NEW) {
             auto s_it = spawns.find(m_it.get_arg(0));
             if(s_it != spawns.end())
                 //  Make sure the number of arguments match what's expected.
@@ -58,17 +199,32 @@ void spawner::process_messages(const message_container& messages) {
                 if(m_it.num_args() == s_it->second.first + 1) {
                     entity_id e_id = mgr::world::new_entity();
                     try {
-                        s_it->second.second(e_id, m_it.get_args());
+                        s_it->second.second(e_id, m_it);
                     } catch(const exception& e) { throw e; }
                 }
+
+            auto p_it = prefabs.find(m_it.get_arg(0));
+            if(p_it != prefabs.end())
+                if(m_it.num_args() == p_it->second.first + 1)
+                    spawn_prefab(p_it->first, p_it->second.second, 1, m_it);
         }
 
-        if(m_it.get_cmd() == "delete") {
-            entity_id delete_entity_id = mgr::world::get_id(m_it.get_arg(0));
-            if(delete_entity_id != mgr::world::ENTITY_ERROR) {
-                mgr::world::delete_entity(delete_entity_id);
+        if(m_it.get_cmd_id() == CMD_BATCH) {
+            auto p_it = prefabs.find(m_it.get_arg(0));
+            //  Do not count the name and count arguments.
+            if(p_it != prefabs.end() && m_it.num_args() == p_it->second.first + 2) {
+                std::size_t count = 0;
+                try {
+                    count = std::stoull(m_it.get_arg(1));
+                } catch(...) { count = 0; }
+                if(count > 0) spawn_prefab(p_it->first, p_it->second.second, count, m_it);
             }
         }
+
+        if(m_it.get_cmd_id() == CMD_DELETE) {
+            entity_id delete_entity_id = mgr::world::get_id(m_it.get_arg(0));
+            if(delete_entity_id != mgr::world::ENTITY_ERROR) despawn(delete_entity_id);
+        }
     }  //  End for(m_it)
 }
 
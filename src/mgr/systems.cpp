@@ -9,6 +9,8 @@
 
 #include "wtengine/mgr/systems.hpp"
 
+#include "wtengine/mgr/renderer.hpp"
+
 namespace wte::mgr {
 
 template <> bool manager<systems>::initialized = false;
@@ -55,8 +57,14 @@ const bool systems::add(sys::system_uptr new_system) {
 void systems::run() {
     for(auto& it: _systems_timed)
         try { 
+            //  Take the display from the render thread if the system needs it.
+            if(it->needs_display) gfx::renderer::hold_display();
             (it)->run();
-        } catch(const exception& e) { throw e; }
+            if(it->needs_display) gfx::renderer::release_display();
+        } catch(const exception& e) {
+            if(it->needs_display) gfx::renderer::release_display();
+            throw e;
+        }
 }
 
 /*
@@ -65,8 +73,14 @@ void systems::run() {
 void systems::run_untimed() {
     for(auto& it: _systems_untimed)
         try { 
+            //  Take the display from the render thread if the system needs it.
+            if(it->needs_display) gfx::renderer::hold_display();
             (it)->run();
-        } catch(const exception& e) { throw e; }
+            if(it->needs_display) gfx::renderer::release_display();
+        } catch(const exception& e) {
+            if(it->needs_display) gfx::renderer::release_display();
+            throw e;
+        }
 }
 
 }  //  end namespace wte::mgr
@@ -15,6 +15,8 @@ template <> bool manager<variables>::initialized = false;
 
 std::string variables::data_file_name = "game.cfg";
 std::map<const std::string, std::any> variables::_map;
+std::map<const std::string, std::size_t> variables::_revisions;
+std::size_t variables::last_revision = 0;
 
 /*
  *
@@ -49,9 +51,19 @@ const bool variables::del(const std::string& var) {
     auto it = _map.find(var);
     if(it != _map.end()) {
         _map.erase(it);
+        _revisions.erase(var);
         return true;
     }
     return false;
 }
 
+/*
+ *
+ */
+const std::size_t variables::revision(const std::string& var) {
+    auto it = _revisions.find(var);
+    if(it != _revisions.end()) return it->second;
+    return 0;
+}
+
 }  //  end namespace wte::mgr
@@ -9,13 +9,25 @@
 
 #include "wtengine/mgr/world.hpp"
 
+#include "wtengine/cmp/motion.hpp"
+#include "wtengine/mgr/spawner.hpp"
+
 namespace wte::mgr {
 
 template <> bool manager<world>::initialized = false;
 
 entity_id world::entity_counter = ENTITY_START;
 entities world::entity_vec;
+std::unordered_map<entity_id, std::size_t> world::entity_index;
+std::unordered_map<entity_id, std::string> world::entity_names;
+std::unordered_map<std::string, entity_id> world::entity_ids;
 world_map world::_world;
+std::unordered_map<entity_id, std::string> world::inactive;
+world_map world::_inactive;
+std::vector<component_change> world::change_log;
+bool world::change_reset = true;
+std::unordered_map<entity_id, int64_t> world::last_touched;
+std::unordered_set<entity_id> world::sleeping;
 
 std::mutex world::entity_mtx;
 std::mutex world::world_mtx;
@@ -28,10 +40,19 @@ void world::clear(void) {
 
     entity_mtx.lock();
     entity_vec.clear();     //  Clear entities vector
+    entity_index.clear();
+    entity_names.clear();   //  Clear lookup indexes
+    entity_ids.clear();
+    last_touched.clear();   //  Clear sleep tracking
+    sleeping.clear();
+    inactive.clear();       //  Clear inactive entities
     entity_mtx.unlock();
 
     world_mtx.lock();
     _world.clear();         //  Clear the world block
+    _inactive.clear();
+    change_log.clear();     //  Clear the change log
+    change_reset = true;
     world_mtx.unlock();
 }
 
@@ -48,9 +69,8 @@ const entity_id world::new_entity(void) {
             if(next_id == ENTITY_MAX) return ENTITY_ERROR;  //  No available ID, error.
             //  See if the new ID does not exist.
             entity_mtx.lock();
-            test = (std::find_if(entity_vec.begin(), entity_vec.end(),
-                                 [&next_id](const entity& e){ return e.first == next_id; })
-                    == entity_vec.end());
+            test = (entity_names.find(next_id) == entity_names.end() &&
+                    inactive.find(next_id) == inactive.end());
             entity_mtx.unlock();
         }
     } else {  //  Counter not max, use the counter for entity ID.
@@ -65,9 +85,7 @@ const entity_id world::new_entity(void) {
         if(temp_id == ENTITY_MAX) return ENTITY_ERROR;  //  Couldn't name entity, error.
         //  See if the new name does not exist.
         entity_mtx.lock();
-        test = (std::find_if(entity_vec.begin(), entity_vec.end(),
-                             [&entity_name](const entity& e){ return e.second == entity_name; })
-                == entity_vec.end());
+        test = (entity_ids.find(entity_name) == entity_ids.end());
         entity_mtx.unlock();
         //  If it does, append the temp number and try that.
         if(!test) entity_name = "Entity" + std::to_string(next_id) + std::to_string(temp_id);
@@ -75,28 +93,142 @@ const entity_id world::new_entity(void) {
 
     //  Tests complete, insert new entity.
     entity_mtx.lock();
-    entity_vec.push_back(std::make_pair(next_id, entity_name));
+    list_entity(next_id, entity_name);
+    entity_names.insert(std::make_pair(next_id, entity_name));
+    entity_ids.insert(std::make_pair(entity_name, next_id));
+    last_touched[next_id] = engine_time::check();
     entity_mtx.unlock();
     return next_id;  //  Return new entity ID.
 }
 
+/*
+ *
+ */
+const std::vector<entity_id> world::new_entities(const std::size_t& count) {
+    std::vector<entity_id> new_ids;
+    new_ids.reserve(count);
+    const int64_t now = engine_time::check();
+
+    entity_mtx.lock();
+    entity_vec.reserve(entity_vec.size() + count);
+    entity_index.reserve(entity_index.size() + count);
+    for(std::size_t i = 0; i < count; i++) {
+        if(entity_counter == ENTITY_MAX) break;  //  Counter hit max, finish one at a time.
+        const entity_id next_id = entity_counter;
+        entity_counter++;
+
+        //  Set a new name.  Make sure name doesn't exist.
+        std::string entity_name = "Entity" + std::to_string(next_id);
+        for(entity_id temp_id = ENTITY_START; entity_ids.find(entity_name) != entity_ids.end(); temp_id++)
+            entity_name = "Entity" + std::to_string(next_id) + std::to_string(temp_id);
+
+        list_entity(next_id, entity_name);
+        entity_names.insert(std::make_pair(next_id, entity_name));
+        entity_ids.insert(std::make_pair(entity_name, next_id));
+        last_touched[next_id] = now;
+        new_ids.push_back(next_id);
+    }
+    entity_mtx.unlock();
+
+    //  Look for available IDs for any remaining entities.
+    while(new_ids.size() < count) {
+        const entity_id next_id = new_entity();
+        if(next_id == ENTITY_ERROR) break;
+        new_ids.push_back(next_id);
+    }
+    return new_ids;
+}
+
 /*
  *
  */
 const bool world::delete_entity(const entity_id& e_id) {
     entity_mtx.lock();
-    auto e_it = std::find_if(entity_vec.begin(), entity_vec.end(),
-                             [&e_id](const entity& e){ return e.first == e_id; });
-    if(e_it == entity_vec.end()) return false;
+    auto n_it = entity_names.find(e_id);
+    if(n_it == entity_names.end()) {
+        //  Inactive entities can also be deleted.
+        const bool found = (inactive.erase(e_id) > 0);
+        entity_mtx.unlock();
+        if(found) {
+            world_mtx.lock();
+            _inactive.erase(e_id);
+            world_mtx.unlock();
+            spawner::forget(e_id);  //  Remove from its pool, if pooled.
+        }
+        return found;
+    }
+    //  Delete the entity while the name iterator is still good.
+    unlist_entity(e_id);
+    entity_ids.erase(n_it->second);
+    entity_names.erase(n_it);
+    last_touched.erase(e_id);
+    sleeping.erase(e_id);
     entity_mtx.unlock();
 
     world_mtx.lock();
+    const auto results = _world.equal_range(e_id);
+    for(auto it = results.first; it != results.second; it++) log_change(e_id, it->second, false);
     _world.erase(e_id);      //  Remove all associated componenets.
     world_mtx.unlock();
+    spawner::forget(e_id);  //  Remove from its pool, if pooled.
+    return true;
+}
 
+/*
+ *
+ */
+const bool world::deactivate_entity(const entity_id& e_id) {
     entity_mtx.lock();
-    entity_vec.erase(e_it);  //  Delete the entity.
+    auto n_it = entity_names.find(e_id);
+    if(n_it == entity_names.end()) {
+        entity_mtx.unlock();
+        return false;
+    }
+    unlist_entity(e_id);
+    inactive.insert(std::make_pair(e_id, n_it->second));
+    entity_ids.erase(n_it->second);
+    entity_names.erase(n_it);
+    last_touched.erase(e_id);
+    sleeping.erase(e_id);
     entity_mtx.unlock();
+
+    //  Move the components out of the world without reallocating them.
+    world_mtx.lock();
+    for(auto it = _world.find(e_id); it != _world.end(); it = _world.find(e_id)) {
+        log_change(e_id, it->second, false);
+        _inactive.insert(_world.extract(it));
+    }
+    world_mtx.unlock();
+    return true;
+}
+
+/*
+ *
+ */
+const bool world::activate_entity(const entity_id& e_id) {
+    entity_mtx.lock();
+    auto i_it = inactive.find(e_id);
+    if(i_it == inactive.end()) {
+        entity_mtx.unlock();
+        return false;
+    }
+    //  Keep the old name unless it has been taken.
+    std::string entity_name = i_it->second;
+    for(entity_id temp_id = ENTITY_START; entity_ids.find(entity_name) != entity_ids.end(); temp_id++)
+        entity_name = "Entity" + std::to_string(e_id) + std::to_string(temp_id);
+    list_entity(e_id, entity_name);
+    entity_names.insert(std::make_pair(e_id, entity_name));
+    entity_ids.insert(std::make_pair(entity_name, e_id));
+    last_touched[e_id] = engine_time::check();
+    inactive.erase(i_it);
+    entity_mtx.unlock();
+
+    world_mtx.lock();
+    for(auto it = _inactive.find(e_id); it != _inactive.end(); it = _inactive.find(e_id)) {
+        log_change(e_id, it->second, true);
+        _world.insert(_inactive.extract(it));
+    }
+    world_mtx.unlock();
     return true;
 }
 
@@ -105,9 +237,7 @@ const bool world::delete_entity(const entity_id& e_id) {
  */
 const bool world::entity_exists(const entity_id& e_id) {
     entity_mtx.lock();
-    const bool result = (std::find_if(entity_vec.begin(), entity_vec.end(),
-        [&e_id](const entity& e){ return e.first == e_id; })
-        != entity_vec.end());
+    const bool result = (entity_names.find(e_id) != entity_names.end());
     entity_mtx.unlock();
     return result;
 }
@@ -117,15 +247,16 @@ const bool world::entity_exists(const entity_id& e_id) {
  */
 const std::string world::get_name(const entity_id& e_id) {
     entity_mtx.lock();
-    auto e_it = std::find_if(entity_vec.begin(), entity_vec.end(),
-                             [&e_id](const entity& e){ return e.first == e_id; });
-    entity_mtx.unlock();
-    if(e_it == entity_vec.end()) {
+    auto n_it = entity_names.find(e_id);
+    if(n_it == entity_names.end()) {
+        entity_mtx.unlock();
         //  Not found, throw error.
         throw exception(
             exception_item("Entity " + std::to_string(e_id) + " does not exist", "World", 4));
     }
-    return e_it->second;
+    const std::string name = n_it->second;
+    entity_mtx.unlock();
+    return name;
 }
 
 /*
@@ -133,16 +264,23 @@ const std::string world::get_name(const entity_id& e_id) {
  */
 const bool world::set_name(const entity_id& e_id, const std::string& name) {
     entity_mtx.lock();
-    auto n_it = std::find_if(entity_vec.begin(), entity_vec.end(),
-                             [&name](const entity& e){ return e.second == name; });
-    entity_mtx.unlock();
-    if(n_it != entity_vec.end()) return false;  //  Entity with the new name exists, error.
-    entity_mtx.lock();
-    auto e_it = std::find_if(entity_vec.begin(), entity_vec.end(),
-                             [&e_id](const entity& e){ return e.first == e_id; });
+    //  Entity with the new name exists, error.
+    if(entity_ids.find(name) != entity_ids.end()) {
+        entity_mtx.unlock();
+        return false;
+    }
+    auto n_it = entity_names.find(e_id);
+    //  Didn't find entity_id, error.
+    if(n_it == entity_names.end()) {
+        entity_mtx.unlock();
+        return false;
+    }
+    auto x_it = entity_index.find(e_id);
+    if(x_it != entity_index.end()) entity_vec[x_it->second].second = name;
+    entity_ids.erase(n_it->second);
+    entity_ids.insert(std::make_pair(name, e_id));
+    n_it->second = name;
     entity_mtx.unlock();
-    if(e_it == entity_vec.end()) return false;  //  Didn't find entity_id, error.
-    e_it->second = name;
     return true;
 }
 
@@ -151,11 +289,10 @@ const bool world::set_name(const entity_id& e_id, const std::string& name) {
  */
 const entity_id world::get_id(const std::string& name) {
     entity_mtx.lock();
-    auto n_it = std::find_if(entity_vec.begin(), entity_vec.end(),
-                             [&name](const entity& e){ return e.second == name; });
+    auto i_it = entity_ids.find(name);
+    const entity_id result = (i_it == entity_ids.end() ? ENTITY_ERROR : i_it->second);
     entity_mtx.unlock();
-    if(n_it == entity_vec.end()) return ENTITY_ERROR;
-    return n_it->first;
+    return result;
 }
 
 /*
@@ -177,6 +314,8 @@ const entity_container world::set_entity(const entity_id& e_id) {
             exception_item("Entity " + std::to_string(e_id) + " does not exist", "World", 4));
     }
 
+    wake_entity(e_id);
+
     entity_container temp_container;
     world_mtx.lock();
     const auto results = _world.equal_range(e_id);
@@ -208,4 +347,185 @@ const const_entity_container world::get_entity(const entity_id& e_id) {
     return temp_container;
 }
 
+/*
+ *
+ */
+const std::size_t world::add_components(
+    const std::vector<std::pair<entity_id, cmp::component_sptr>>& comps
+) {
+    //  Skip components for entities that do not exist.
+    std::vector<bool> added(comps.size(), false);
+    entity_mtx.lock();
+    for(std::size_t i = 0; i < comps.size(); i++)
+        added[i] = (comps[i].second && entity_names.find(comps[i].first) != entity_names.end());
+    entity_mtx.unlock();
+
+    std::size_t count = 0;
+    world_mtx.lock();
+    _world.reserve(_world.size() + comps.size());
+    for(std::size_t i = 0; i < comps.size(); i++) {
+        if(!added[i]) continue;
+        //  Make sure one of the same type does not already exist.
+        const auto results = _world.equal_range(comps[i].first);
+        for(auto it = results.first; it != results.second; it++) {
+            if(typeid(*it->second) == typeid(*comps[i].second)) {
+                added[i] = false;
+                break;
+            }
+        }
+        if(!added[i]) continue;
+        _world.insert(comps[i]);
+        log_change(comps[i].first, comps[i].second, true);
+        count++;
+    }
+    world_mtx.unlock();
+
+    //  Wake the entities that were changed.
+    const int64_t now = engine_time::check();
+    entity_mtx.lock();
+    for(std::size_t i = 0; i < comps.size(); i++) {
+        if(!added[i]) continue;
+        sleeping.erase(comps[i].first);
+        last_touched[comps[i].first] = now;
+    }
+    entity_mtx.unlock();
+    return count;
+}
+
+/*
+ *
+ */
+const bool world::sleep_entity(const entity_id& e_id) {
+    entity_mtx.lock();
+    if(last_touched.erase(e_id) == 0) {
+        //  Already sleeping or does not exist.
+        const bool result = (sleeping.find(e_id) != sleeping.end());
+        entity_mtx.unlock();
+        return result;
+    }
+    sleeping.insert(e_id);
+    entity_mtx.unlock();
+    return true;
+}
+
+/*
+ *
+ */
+const bool world::wake_entity(const entity_id& e_id) {
+    entity_mtx.lock();
+    if(sleeping.erase(e_id) == 0 && last_touched.find(e_id) == last_touched.end()) {
+        entity_mtx.unlock();
+        return false;  //  Entity does not exist.
+    }
+    last_touched[e_id] = engine_time::check();
+    entity_mtx.unlock();
+    return true;
+}
+
+/*
+ *
+ */
+void world::wake_entities(const std::vector<entity_id>& e_ids) {
+    const int64_t now = engine_time::check();
+    entity_mtx.lock();
+    for(auto& e_id: e_ids) {
+        if(sleeping.erase(e_id) == 0 && last_touched.find(e_id) == last_touched.end()) continue;
+        last_touched[e_id] = now;
+    }
+    entity_mtx.unlock();
+}
+
+/*
+ *
+ */
+const bool world::is_sleeping(const entity_id& e_id) {
+    entity_mtx.lock();
+    const bool result = (sleeping.find(e_id) != sleeping.end());
+    entity_mtx.unlock();
+    return result;
+}
+
+/*
+ *
+ */
+void world::update_sleeping(void) {
+    if constexpr (build_options.entity_sleep_ticks <= 0) return;
+    else {
+        const int64_t now = engine_time::check();
+        std::vector<entity_id> idle;
+
+        //  Find entities that have not been touched in the set number of ticks.
+        entity_mtx.lock();
+        for(auto& it: last_touched)
+            if(now - it.second >= build_options.entity_sleep_ticks) idle.push_back(it.first);
+        entity_mtx.unlock();
+
+        for(auto& e_id: idle) {
+            //  Entities still in motion stay awake.
+            bool moving = false;
+            world_mtx.lock();
+            const auto results = _world.equal_range(e_id);
+            for(auto it = results.first; it != results.second; it++) {
+                auto m = std::dynamic_pointer_cast<cmp::motion>(it->second);
+                if(m && (m->x_vel != 0.0f || m->y_vel != 0.0f)) {
+                    moving = true;
+                    break;
+                }
+            }
+            world_mtx.unlock();
+            if(!moving) sleep_entity(e_id);
+        }
+    }
+}
+
+/*
+ *
+ */
+void world::list_entity(const entity_id& e_id, const std::string& name) {
+    entity_index[e_id] = entity_vec.size();
+    entity_vec.push_back(std::make_pair(e_id, name));
+}
+
+/*
+ *
+ */
+void world::unlist_entity(const entity_id& e_id) {
+    auto x_it = entity_index.find(e_id);
+    if(x_it == entity_index.end()) return;
+    const std::size_t pos = x_it->second;
+    entity_index.erase(x_it);
+    //  Move the last entity into the gap, so nothing has to shift.
+    if(pos + 1 < entity_vec.size()) {
+        entity_vec[pos] = std::move(entity_vec.back());
+        entity_index[entity_vec[pos].first] = pos;
+    }
+    entity_vec.pop_back();
+}
+
+/*
+ *
+ */
+void world::log_change(const entity_id& e_id, const cmp::component_csptr& comp, const bool& added) {
+    if(change_reset) return;  //  Already incomplete, the world will be read again.
+    if(change_log.size() >= CHANGE_LOG_MAX) {
+        change_log.clear();
+        change_reset = true;
+        return;
+    }
+    change_log.push_back({ e_id, comp, added });
+}
+
+/*
+ *
+ */
+const bool world::take_changes(std::vector<component_change>& changes) {
+    changes.clear();
+    world_mtx.lock();
+    std::swap(changes, change_log);
+    const bool reset = change_reset;
+    change_reset = false;
+    world_mtx.unlock();
+    return reset;
+}
+
 }  //  end namespace wte::mgr
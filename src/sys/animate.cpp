@@ -21,11 +21,11 @@ animate::animate() : system("animate") {}
  */
 void animate::run(void) {
     component_container<cmp::gfx::gfx> animation_components =
-        mgr::world::set_components<cmp::gfx::gfx>();
+        mgr::world::set_active_components<cmp::gfx::gfx>();
 
     for(auto& it: animation_components)
         try {
-            if(it.second->visible) it.second->animate(it.first);
+            if(it.second->visible && it.second->needs_redraw()) it.second->animate(it.first, *it.second);
         } catch(...) { throw; }
 }
 
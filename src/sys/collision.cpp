@@ -14,7 +14,7 @@ namespace wte::sys {
 /*
  *
  */
-colision::colision() : system("colision") {}
+colision::colision() : system("colision", true, false) {}
 
 /*
  *
@@ -23,45 +23,57 @@ void colision::run(void) {
     const_component_container<cmp::hitbox> hitbox_components =
         mgr::world::get_components<cmp::hitbox>();
 
-    for(auto& it_a: hitbox_components) {
-        for(auto& it_b: hitbox_components) {
-            try {
-                cmp::const_comp_ptr<cmp::location> temp_location_a =
-                    mgr::world::get_component<cmp::location>(it_a.first);
-                cmp::const_comp_ptr<cmp::location> temp_location_b =
-                    mgr::world::get_component<cmp::location>(it_b.first);
+    //  Look up each entity's location and sleep state once.
+    coliders.clear();
+    for(auto& it: hitbox_components) {
+        try {
+            coliders.push_back({
+                it.first,
+                it.second,
+                mgr::world::get_component<cmp::location>(it.first),
+                mgr::world::is_sleeping(it.first)
+            });
+        } catch(...) { throw; }
+    }
 
-                /*
-                 * Only test if:  Not the same entity.
-                 *                Entities are on different teams.
-                 *                Both entities are solid.
-                 */
+    for(auto& a: coliders) {
+        for(auto& b: coliders) {
+            /*
+             * Only test if:  Not the same entity.
+             *                At least one entity is awake.
+             *                Entities are on different teams.
+             *                Both entities are solid.
+             */
+            if(
+                a.e_id != b.e_id &&
+                !(a.sleeping && b.sleeping) &&
+                a.hitbox->team != b.hitbox->team &&
+                a.hitbox->solid && b.hitbox->solid
+            ) {
+                //  Use AABB to test colision
                 if(
-                    it_a.first != it_b.first &&
-                    it_a.second->team != it_b.second->team &&
-                    it_a.second->solid && it_b.second->solid
+                    a.location->pos_x < b.location->pos_x + b.hitbox->width &&
+                    a.location->pos_x + a.hitbox->width > b.location->pos_x &&
+                    a.location->pos_y < b.location->pos_y + b.hitbox->height &&
+                    a.location->pos_y + a.hitbox->height > b.location->pos_y
                 ) {
-                    //  Use AABB to test colision
-                    if(
-                        temp_location_a->pos_x < temp_location_b->pos_x + it_b.second->width &&
-                        temp_location_a->pos_x + it_a.second->width > temp_location_b->pos_x &&
-                        temp_location_a->pos_y < temp_location_b->pos_y + it_b.second->height &&
-                        temp_location_a->pos_y + it_a.second->height > temp_location_b->pos_y
-                    ) {
+                    try {
                         //  Send a message that two entities colided.
                         //  Each entity will get a colision message.
                         //  Ex:  A hit B, B hit A.
                         mgr::messages::add(
                             message("entities",
-                                    mgr::world::get_name(it_a.first),
-                                    mgr::world::get_name(it_b.first),
+                                    mgr::world::get_name(a.e_id),
+                                    mgr::world::get_name(b.e_id),
                                     "colision", "")
                         );
-                    }
-                } //  End skip self check
-            } catch(...) { throw; }
-        } //  End it_b loop
-    } //  End it_a loop
+                        mgr::world::wake_entity(a.e_id);
+                        mgr::world::wake_entity(b.e_id);
+                    } catch(...) { throw; }
+                }
+            } //  End skip check
+        } //  End b loop
+    } //  End a loop
 }
 
 }  //  end namespace wte::sys
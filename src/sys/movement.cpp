@@ -14,43 +14,111 @@ namespace wte::sys {
 /*
  *
  */
-movement::movement() : system("movement") {}
+movement::movement() : system("movement", true, false) {}
 
 /*
  *
  */
 void movement::run(void) {
-    //  Find the entities with a motion component.
-    const_component_container<cmp::motion> vel_components
-        = mgr::world::get_components<cmp::motion>();
-    for(auto& it: vel_components) {
-        try {
-            cmp::const_comp_ptr<cmp::location> temp_get =
-                mgr::world::get_component<cmp::location>(it.first);
-            cmp::comp_ptr<cmp::location> temp_set =
-                mgr::world::set_component<cmp::location>(it.first);
+    //  Find the awake entities with a motion or bounding box component.
+    component_container<cmp::motion> vel_components =
+        mgr::world::set_active_components<cmp::motion>();
+    const_component_container<cmp::bounding_box> bbox_components =
+        mgr::world::get_active_components<cmp::bounding_box>();
+
+    ids.clear();
+    locations.clear();
+    pos_x.clear();  pos_y.clear();
+    vel_x.clear();  vel_y.clear();
+    min_x.clear();  min_y.clear();
+    max_x.clear();  max_y.clear();
+
+    constexpr float no_min = -std::numeric_limits<float>::infinity();
+    constexpr float no_max = std::numeric_limits<float>::infinity();
+
+    //  Both containers are sorted by entity ID, walk them together
+    //  and pack the data for each entity into the arrays.
+    auto v_it = vel_components.begin();
+    auto b_it = bbox_components.begin();
+    while(v_it != vel_components.end() || b_it != bbox_components.end()) {
+        entity_id e_id;
+        if(b_it == bbox_components.end() ||
+           (v_it != vel_components.end() && v_it->first <= b_it->first)) e_id = v_it->first;
+        else e_id = b_it->first;
 
-            temp_set->pos_x += (it.second->x_vel * std::cos(it.second->direction));
-            temp_set->pos_y += (it.second->y_vel * std::sin(it.second->direction));
+        try {
+            //  Keep the location to write back to.  Not woken until it moves.
+            cmp::location* loc = mgr::world::set_component_quiet<cmp::location>(e_id).get();
+            ids.push_back(e_id);
+            locations.push_back(loc);
+            pos_x.push_back(loc->pos_x);
+            pos_y.push_back(loc->pos_y);
         } catch(...) { throw; }
+
+        if(v_it != vel_components.end() && v_it->first == e_id) {
+            //  Only recalculate the direction vector when the direction changes.
+            cmp::motion& m = *v_it->second;
+            if(m.direction != m.cached_direction) {
+                m.cached_direction = m.direction;
+                m.dir_x = std::cos(m.direction);
+                m.dir_y = std::sin(m.direction);
+            }
+            vel_x.push_back(m.x_vel * m.dir_x);
+            vel_y.push_back(m.y_vel * m.dir_y);
+            v_it++;
+        } else {
+            vel_x.push_back(0.0f);
+            vel_y.push_back(0.0f);
+        }
+
+        if(b_it != bbox_components.end() && b_it->first == e_id) {
+            min_x.push_back(b_it->second->min_x);
+            min_y.push_back(b_it->second->min_y);
+            max_x.push_back(b_it->second->max_x);
+            max_y.push_back(b_it->second->max_y);
+            b_it++;
+        } else {
+            min_x.push_back(no_min);
+            min_y.push_back(no_min);
+            max_x.push_back(no_max);
+            max_y.push_back(no_max);
+        }
     }
 
-    //  Now check all bounding boxes.
-    const_component_container<cmp::bounding_box> bbox_components =
-        mgr::world::get_components<cmp::bounding_box>();
-    for(auto& it: bbox_components) {
-        try{
-            cmp::const_comp_ptr<cmp::location> temp_get =
-                mgr::world::get_component<cmp::location>(it.first);
-            cmp::comp_ptr<cmp::location> temp_set =
-                mgr::world::set_component<cmp::location>(it.first);
-
-            if(temp_get->pos_x < it.second->min_x) temp_set->pos_x = it.second->min_x;
-            else if(temp_get->pos_x > it.second->max_x) temp_set->pos_x = it.second->max_x;
-
-            if(temp_get->pos_y < it.second->min_y) temp_set->pos_y = it.second->min_y;
-            else if(temp_get->pos_y > it.second->max_y) temp_set->pos_y = it.second->max_y;
-        } catch(...) { throw; }
+    //  Move and clamp to the bounding box, one axis at a time.
+    const std::size_t count = ids.size();
+    old_x = pos_x;
+    old_y = pos_y;
+    integrate(pos_x.data(), vel_x.data(), min_x.data(), max_x.data(), count);
+    integrate(pos_y.data(), vel_y.data(), min_y.data(), max_y.data(), count);
+
+    //  Write back only the locations that changed, then wake those entities.
+    moved.clear();
+    for(std::size_t i = 0; i < count; i++) {
+        if(pos_x[i] == old_x[i] && pos_y[i] == old_y[i]) continue;
+        locations[i]->pos_x = pos_x[i];
+        locations[i]->pos_y = pos_y[i];
+        moved.push_back(ids[i]);
+    }
+    if(!moved.empty()) mgr::world::wake_entities(moved);
+}
+
+/*
+ *
+ */
+void movement::integrate(
+    float* pos,
+    const float* vel,
+    const float* min,
+    const float* max,
+    const std::size_t& count
+) {
+    //  Kept branch free so the compiler can vectorize it.
+    for(std::size_t i = 0; i < count; i++) {
+        float p = pos[i] + vel[i];
+        p = (p < min[i] ? min[i] : p);
+        p = (p > max[i] ? max[i] : p);
+        pos[i] = p;
     }
 }
 
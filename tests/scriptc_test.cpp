@@ -0,0 +1,150 @@
+/*!
+ * wtengine | File:  scriptc_test.cpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+/*
+ * Check a script compiled by wte-scriptc from data/partial_types.csv.
+ *
+ * Usage:  scriptc_test compiled.sdf
+ *
+ * Rows in the input mix string and typed arguments.  The payload of each
+ * record must line up with its arguments:  string arguments hold an empty
+ * value and typed arguments sit at the same position as in the args column.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <fstream>
+#include <iostream>
+
+#include "wtengine/_globals/script_format.hpp"
+
+namespace {
+
+//  Expected payload value for one argument.
+struct expected_value {
+    uint32_t type;
+    int64_t int_value;
+    float float_value;
+};
+
+//  Expected contents of one record.
+struct expected_record {
+    int64_t timer;
+    std::string cmd;
+    std::string args;
+    std::vector<expected_value> values;
+};
+
+int failures = 0;
+
+/*
+ * Report a failed check.
+ */
+void check(const bool& test, const std::string& msg) {
+    if(test) return;
+    std::cerr << "Failed:  " << msg << std::endl;
+    failures++;
+}
+
+}  //  end namespace
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        std::cerr << "Usage:  scriptc_test compiled.sdf" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if(!in) {
+        std::cerr << "Unable to open '" << argv[1] << "'." << std::endl;
+        return 1;
+    }
+    const std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    //  Read the header.
+    wte::script::header head;
+    if(data.size() < sizeof(head)) {
+        std::cerr << "File too small for a script header." << std::endl;
+        return 1;
+    }
+    std::memcpy(&head, data.data(), sizeof(head));
+    check(std::equal(head.magic, head.magic + 4, wte::script::MAGIC), "magic");
+    check(head.version == wte::script::VERSION, "version");
+    if(head.payload_offset + head.payload_count * sizeof(wte::script::value) > data.size()) {
+        std::cerr << "Script sections run past the end of the file." << std::endl;
+        return 1;
+    }
+
+    //  Read the string table, records and payload.
+    std::vector<uint32_t> string_offsets(head.string_count);
+    std::memcpy(string_offsets.data(), data.data() + head.string_offset, string_offsets.size() * sizeof(uint32_t));
+    const char* string_data = data.data() + head.string_offset + string_offsets.size() * sizeof(uint32_t);
+    auto text = [&](const uint32_t& i) {
+        return (i < string_offsets.size() ? std::string(string_data + string_offsets[i]) : std::string());
+    };
+
+    std::vector<wte::script::record> records(head.record_count);
+    std::memcpy(records.data(), data.data() + head.record_offset, records.size() * sizeof(wte::script::record));
+    std::vector<wte::script::value> values(head.payload_count);
+    std::memcpy(values.data(), data.data() + head.payload_offset, values.size() * sizeof(wte::script::value));
+
+    using namespace wte::script;
+    const std::vector<expected_record> expected = {
+        { 0, "sample-play", "sfx;tag;0.5;-0.25;1.5",
+            { { VALUE_NONE, 0, 0.0f }, { VALUE_NONE, 0, 0.0f },
+              { VALUE_FLOAT, 0, 0.5f }, { VALUE_FLOAT, 0, -0.25f }, { VALUE_FLOAT, 0, 1.5f } } },
+        { 1, "sample-play", "sfx;tag;0.75",
+            { { VALUE_NONE, 0, 0.0f }, { VALUE_NONE, 0, 0.0f }, { VALUE_FLOAT, 0, 0.75f } } },
+        { 2, "spawn", "enemy;10;true;boss",
+            { { VALUE_NONE, 0, 0.0f }, { VALUE_INT, 10, 0.0f },
+              { VALUE_BOOL, 1, 0.0f }, { VALUE_NONE, 0, 0.0f } } },
+        { 3, "exit", "", {} },
+        { 4, "score", "1;two;3", { { VALUE_INT, 1, 0.0f } } }
+    };
+
+    check(records.size() == expected.size(), "record count");
+    for(std::size_t r = 0; r < std::min(records.size(), expected.size()); r++) {
+        const record& rec = records[r];
+        const expected_record& exp = expected[r];
+        const std::string where = "record " + std::to_string(r) + ":  ";
+
+        check(rec.timer == exp.timer, where + "timer");
+        check(text(rec.cmd) == exp.cmd, where + "command");
+        check(text(rec.args) == exp.args, where + "arguments");
+        check(rec.payload_count == exp.values.size(), where + "payload count");
+        if(rec.payload_start + rec.payload_count > values.size()) {
+            check(false, where + "payload out of range");
+            continue;
+        }
+
+        for(std::size_t i = 0; i < std::min<std::size_t>(rec.payload_count, exp.values.size()); i++) {
+            const value& v = values[rec.payload_start + i];
+            const expected_value& ev = exp.values[i];
+            const std::string at = where + "payload " + std::to_string(i) + " ";
+            check(v.type == ev.type, at + "type");
+            if(v.type == VALUE_FLOAT) check(v.float_value == ev.float_value, at + "float value");
+            else check(v.int_value == ev.int_value, at + "int value");
+        }
+    }
+
+    if(failures > 0) {
+        std::cerr << failures << " checks failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*!
+ * wtengine | File:  sprite_pool_test.cpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+/*
+ * Reset a sprite the way a pooled respawn does and animate it.
+ *
+ * A pooled entity's components are rebuilt by move assigning a new component
+ * over the old one.  The animation must then run on the reset sprite, not on
+ * the temporary it was built from.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <allegro5/allegro.h>
+
+#include "wtengine/wtengine.hpp"
+
+namespace {
+
+int failures = 0;
+
+/*
+ * Report a failed check.
+ */
+void check(const bool& test, const std::string& msg) {
+    if(test) return;
+    std::cerr << "Failed:  " << msg << std::endl;
+    failures++;
+}
+
+}  //  end namespace
+
+/*
+ *
+ */
+int main(void) {
+    if(!al_init()) {
+        std::cerr << "Unable to initialize Allegro." << std::endl;
+        return 1;
+    }
+
+    using namespace wte;
+    //  Sheet of four 16x16 frames.
+    const wte_asset<al_bitmap> sheet = make_asset(al_bitmap(64, 16));
+    sys::gfx::animate animator;
+
+    const entity_id e_id = mgr::world::new_entity();
+    check(mgr::world::add_component<cmp::gfx::sprite>(e_id, sheet, 0, 16.0f, 16.0f, 0.0f, 0.0f, 1),
+        "add sprite");
+    animator.run();
+
+    for(int spawn = 0; spawn < 3; spawn++) {
+        const std::string where = "spawn " + std::to_string(spawn) + ":  ";
+        //  Reset the sprite in place, as the spawner does for a pooled entity.
+        auto spr = mgr::world::set_component<cmp::gfx::sprite>(e_id);
+        *spr = cmp::gfx::sprite(sheet, 0, 16.0f, 16.0f, 0.0f, 0.0f, 1);
+        check(spr->get_frame() == 0, where + "frame after reset");
+
+        spr->add_cycle("run", 0, 3);
+        spr->set_cycle("run");
+        animator.run();
+        check(spr->get_frame() == 1, where + "frame after first animation");
+        animator.run();
+        check(spr->get_frame() == 2, where + "frame after second animation");
+    }
+
+    mgr::world::delete_entity(e_id);
+
+    if(failures > 0) {
+        std::cerr << failures << " checks failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,419 @@
+/*!
+ * wtengine | File:  scriptc.cpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+/*
+ * Convert a CSV or JSON game script into the indexed script format.
+ *
+ * Usage:  wte-scriptc input.csv|input.json [output]
+ *
+ * Each row is:  timer, sys, to, from, cmd, args [, types]
+ * The optional types column lists a type for each argument, delimited by ;
+ *   s - string (default)
+ *   i - integer
+ *   f - float
+ *   b - bool (true/false or 1/0)
+ * Typed arguments are also stored in the message payload, in argument order.
+ * String arguments get an empty payload value, so a payload position is
+ * always the same as its argument position.
+ *
+ * JSON input is an array (or object) of row arrays.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "wtengine/_globals/script_format.hpp"
+
+namespace {
+
+//  A single row of the input script.
+typedef std::vector<std::string> row;
+
+//  A parsed message ready to be written.
+struct entry {
+    int64_t timer;
+    uint32_t sys, to, from, cmd, args;
+    std::vector<wte::script::value> values;
+};
+
+/*
+ * Print an error and exit.
+ */
+[[noreturn]] void error(const std::string& msg) {
+    std::cerr << "Error:  " << msg << std::endl;
+    std::exit(1);
+}
+
+/*
+ * Parse CSV data.  Supports quoted fields with "" escapes.
+ */
+const std::vector<row> parse_csv(const std::string& data) {
+    std::vector<row> rows;
+    row current;
+    std::string field;
+    bool quoted = false, field_started = false;
+
+    for(std::size_t i = 0; i < data.size(); i++) {
+        const char ch = data[i];
+        if(quoted) {
+            if(ch == '"') {
+                if(i + 1 < data.size() && data[i + 1] == '"') { field += '"'; i++; }
+                else quoted = false;
+            } else field += ch;
+            continue;
+        }
+        switch(ch) {
+            case '"':
+                quoted = true;
+                field_started = true;
+                break;
+            case ',':
+                current.push_back(field);
+                field.clear();
+                field_started = true;
+                break;
+            case '\r':
+                break;
+            case '\n':
+                if(field_started || !field.empty() || !current.empty()) {
+                    current.push_back(field);
+                    rows.push_back(current);
+                }
+                current.clear();
+                field.clear();
+                field_started = false;
+                break;
+            default:
+                field += ch;
+                field_started = true;
+        }
+    }
+    if(quoted) error("Unterminated quote in CSV data.");
+    if(field_started || !field.empty() || !current.empty()) {
+        current.push_back(field);
+        rows.push_back(current);
+    }
+    return rows;
+}
+
+/*
+ * Minimal JSON reader.  Collects every array of scalars as a row.
+ */
+class json_reader {
+    public:
+        json_reader(const std::string& d) : data(d), pos(0) {};
+
+        const std::vector<row> parse(void) {
+            std::vector<row> rows;
+            skip_space();
+            if(peek() == '[') {
+                pos++;
+                read_rows(']', rows);
+            } else if(peek() == '{') {
+                pos++;
+                read_rows('}', rows);
+            } else error("JSON data must be an array or object of rows.");
+            skip_space();
+            if(pos != data.size()) error("Unexpected data after JSON.");
+            return rows;
+        };
+
+    private:
+        char peek(void) {
+            if(pos >= data.size()) error("Unexpected end of JSON data.");
+            return data[pos];
+        };
+
+        void skip_space(void) {
+            while(pos < data.size() && std::isspace(static_cast<unsigned char>(data[pos]))) pos++;
+        };
+
+        void expect(const char& ch) {
+            skip_space();
+            if(peek() != ch) error(std::string("Expected '") + ch + "' in JSON data.");
+            pos++;
+        };
+
+        //  Read the rows of the top level container.
+        void read_rows(const char& close, std::vector<row>& rows) {
+            skip_space();
+            if(peek() == close) { pos++; return; }
+            while(true) {
+                skip_space();
+                if(close == '}') {
+                    read_string();  //  Key, not used.
+                    expect(':');
+                    skip_space();
+                }
+                if(peek() != '[') error("Each JSON row must be an array.");
+                pos++;
+                rows.push_back(read_row());
+                skip_space();
+                if(peek() == ',') { pos++; continue; }
+                expect(close);
+                return;
+            }
+        };
+
+        //  Read an array of scalars.
+        const row read_row(void) {
+            row r;
+            skip_space();
+            if(peek() == ']') { pos++; return r; }
+            while(true) {
+                r.push_back(read_scalar());
+                skip_space();
+                if(peek() == ',') { pos++; continue; }
+                expect(']');
+                return r;
+            }
+        };
+
+        const std::string read_scalar(void) {
+            skip_space();
+            if(peek() == '"') return read_string();
+            const std::size_t start = pos;
+            while(pos < data.size() && data[pos] != ',' && data[pos] != ']' &&
+                  !std::isspace(static_cast<unsigned char>(data[pos]))) pos++;
+            const std::string value = data.substr(start, pos - start);
+            if(value.empty()) error("Expected a value in JSON data.");
+            if(value == "null") return "";
+            return value;
+        };
+
+        const std::string read_string(void) {
+            expect('"');
+            std::string result;
+            while(true) {
+                const char ch = peek();
+                pos++;
+                if(ch == '"') return result;
+                if(ch != '\\') { result += ch; continue; }
+                const char esc = peek();
+                pos++;
+                switch(esc) {
+                    case 'n': result += '\n'; break;
+                    case 't': result += '\t'; break;
+                    case 'r': result += '\r'; break;
+                    case 'b': result += '\b'; break;
+                    case 'f': result += '\f'; break;
+                    case 'u': {
+                        if(pos + 4 > data.size()) error("Bad unicode escape in JSON data.");
+                        const unsigned long code = std::stoul(data.substr(pos, 4), nullptr, 16);
+                        pos += 4;
+                        //  Encode as UTF-8.
+                        if(code < 0x80) result += static_cast<char>(code);
+                        else if(code < 0x800) {
+                            result += static_cast<char>(0xC0 | (code >> 6));
+                            result += static_cast<char>(0x80 | (code & 0x3F));
+                        } else {
+                            result += static_cast<char>(0xE0 | (code >> 12));
+                            result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                            result += static_cast<char>(0x80 | (code & 0x3F));
+                        }
+                        break;
+                    }
+                    default: result += esc;
+                }
+            }
+        };
+
+        const std::string& data;
+        std::size_t pos;
+};
+
+/*
+ * Split a string by ;
+ */
+const std::vector<std::string> split(const std::string& str) {
+    std::vector<std::string> result;
+    std::string segment;
+    std::stringstream stream(str);
+    while(std::getline(stream, segment, ';')) result.push_back(segment);
+    return result;
+}
+
+/*
+ * Convert an argument to a typed payload value.
+ */
+const wte::script::value make_value(
+    const std::string& type,
+    const std::string& arg,
+    const std::size_t& row_num
+) {
+    wte::script::value v;
+    std::memset(&v, 0, sizeof(v));
+    const std::string where = "Row " + std::to_string(row_num) + ":  ";
+    std::size_t used = 0;
+    try {
+        if(type == "i") {
+            v.type = wte::script::VALUE_INT;
+            v.int_value = std::stoll(arg, &used);
+        } else if(type == "f") {
+            v.type = wte::script::VALUE_FLOAT;
+            v.float_value = std::stof(arg, &used);
+        } else if(type == "b") {
+            v.type = wte::script::VALUE_BOOL;
+            if(arg == "true" || arg == "1") v.int_value = 1;
+            else if(arg == "false" || arg == "0") v.int_value = 0;
+            else error(where + "'" + arg + "' is not a bool.");
+            used = arg.size();
+        } else error(where + "unknown type hint '" + type + "'.");
+    } catch(const std::logic_error&) {
+        error(where + "'" + arg + "' is not a valid number.");
+    }
+    if(used != arg.size()) error(where + "'" + arg + "' is not a valid number.");
+    return v;
+}
+
+}  //  end namespace
+
+/*
+ *
+ */
+int main(int argc, char** argv) {
+    if(argc < 2) error("Please specify an input file.\nUsage:  wte-scriptc input.csv|input.json [output]");
+
+    const std::string in_file = argv[1];
+    std::string out_file = (argc > 2 ? argv[2] : in_file.substr(0, in_file.find_last_of('.')) + ".sdf");
+
+    std::ifstream in(in_file, std::ios::binary);
+    if(!in) error("Input file '" + in_file + "' does not exist.");
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string data = buffer.str();
+
+    std::string ext = in_file.substr(in_file.find_last_of('.') + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    std::vector<row> rows;
+    if(ext == "csv") rows = parse_csv(data);
+    else if(ext == "json") rows = json_reader(data).parse();
+    else error("File format '" + ext + "' not supported.");
+    std::cout << rows.size() << " rows read from '" << in_file << "'." << std::endl;
+
+    //  Build the string table, storing each string once.
+    std::vector<std::string> strings = { "" };
+    std::unordered_map<std::string, uint32_t> string_ids = { { "", 0 } };
+    auto add_string = [&strings, &string_ids](const std::string& str) {
+        auto it = string_ids.find(str);
+        if(it != string_ids.end()) return it->second;
+        const uint32_t id = static_cast<uint32_t>(strings.size());
+        strings.push_back(str);
+        string_ids.insert(std::make_pair(str, id));
+        return id;
+    };
+
+    //  Validate and convert each row.
+    std::vector<entry> entries;
+    entries.reserve(rows.size());
+    std::size_t row_num = 0;
+    for(auto& r: rows) {
+        row_num++;
+        const std::string where = "Row " + std::to_string(row_num) + ":  ";
+        if(r.size() != 6 && r.size() != 7) error(where + "incorrect length.");
+        if(r[1].empty()) error(where + "missing system.");
+        if(r[4].empty()) error(where + "missing command.");
+
+        entry e;
+        std::size_t used = 0;
+        try { e.timer = std::stoll(r[0], &used); } catch(const std::logic_error&) { used = 0; }
+        if(r[0].empty() || used != r[0].size() || e.timer < -1) error(where + "invalid timer '" + r[0] + "'.");
+
+        e.sys = add_string(r[1]);
+        e.to = add_string(r[2]);
+        e.from = add_string(r[3]);
+        e.cmd = add_string(r[4]);
+        e.args = add_string(r[5]);
+
+        //  Convert typed arguments.
+        if(r.size() == 7 && !r[6].empty()) {
+            const std::vector<std::string> types = split(r[6]);
+            const std::vector<std::string> args = split(r[5]);
+            if(types.size() > args.size()) error(where + "more type hints than arguments.");
+            for(std::size_t i = 0; i < types.size(); i++) {
+                if(types[i] == "s" || types[i].empty()) {
+                    //  Keep the position of later typed arguments.
+                    wte::script::value v;
+                    std::memset(&v, 0, sizeof(v));
+                    v.type = wte::script::VALUE_NONE;
+                    e.values.push_back(v);
+                } else e.values.push_back(make_value(types[i], args[i], row_num));
+            }
+        }
+        entries.push_back(e);
+    }
+
+    //  Sort by timer, keeping the file order for messages on the same tick.
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const entry& a, const entry& b) { return a.timer < b.timer; });
+
+    //  Lay out the string table.
+    std::vector<uint32_t> string_offsets;
+    std::string string_data;
+    for(auto& it: strings) {
+        string_offsets.push_back(static_cast<uint32_t>(string_data.size()));
+        string_data += it;
+        string_data += '\0';
+    }
+
+    //  Lay out the records and payload.
+    std::vector<wte::script::record> records;
+    std::vector<wte::script::value> values;
+    for(auto& e: entries) {
+        wte::script::record rec;
+        std::memset(&rec, 0, sizeof(rec));
+        rec.timer = e.timer;
+        rec.sys = e.sys;
+        rec.to = e.to;
+        rec.from = e.from;
+        rec.cmd = e.cmd;
+        rec.args = e.args;
+        rec.payload_start = static_cast<uint32_t>(values.size());
+        rec.payload_count = static_cast<uint32_t>(e.values.size());
+        values.insert(values.end(), e.values.begin(), e.values.end());
+        records.push_back(rec);
+    }
+
+    wte::script::header head;
+    std::memset(&head, 0, sizeof(head));
+    std::memcpy(head.magic, wte::script::MAGIC, sizeof(head.magic));
+    head.version = wte::script::VERSION;
+    head.string_count = static_cast<uint32_t>(strings.size());
+    head.record_count = static_cast<uint32_t>(records.size());
+    head.payload_count = static_cast<uint32_t>(values.size());
+    head.string_offset = sizeof(head);
+    head.record_offset = head.string_offset +
+        string_offsets.size() * sizeof(uint32_t) + string_data.size();
+    head.payload_offset = head.record_offset + records.size() * sizeof(wte::script::record);
+
+    //  Write out the file.
+    std::ofstream out(out_file, std::ios::binary | std::ios::trunc);
+    if(!out) error("Unable to write output file '" + out_file + "'.");
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    out.write(reinterpret_cast<const char*>(string_offsets.data()), string_offsets.size() * sizeof(uint32_t));
+    out.write(string_data.data(), string_data.size());
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(wte::script::record));
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(wte::script::value));
+    if(!out) error("Writing output file '" + out_file + "' failed.");
+
+    std::cout << "Wrote '" << out_file << "':  " << records.size() << " messages, "
+              << strings.size() << " strings, " << values.size() << " typed values." << std::endl;
+    return 0;
+}
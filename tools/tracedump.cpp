@@ -0,0 +1,136 @@
+/*!
+ * wtengine | File:  tracedump.cpp
+ * 
+ * \author Matthew Evans
+ * \version 0.7.2
+ * \copyright See LICENSE.md for copyright information.
+ * \date 2019-2022
+ */
+
+/*
+ * Convert a binary message trace into text.
+ *
+ * Usage:  wte-tracedump input.trace [output]
+ *
+ * Traces are written to wte_debug/messages.trace when the engine is built in debug mode.
+ * Writes to standard output if no output file is given.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <iostream>
+
+#include "wtengine/_debug/trace_format.hpp"
+
+namespace {
+
+/*
+ * Print an error and exit.
+ */
+[[noreturn]] void error(const std::string& msg) {
+    std::cerr << "Error:  " << msg << std::endl;
+    std::exit(1);
+}
+
+}  //  end anonymous namespace
+
+/*
+ * Read the trace and write each message in the text log format.
+ */
+int main(int argc, char** argv) {
+    if(argc < 2) error("Please specify an input file.\nUsage:  wte-tracedump input.trace [output]");
+
+    const std::string in_file = argv[1];
+    std::ifstream in(in_file, std::ios::binary);
+    if(!in) error("Input file '" + in_file + "' does not exist.");
+
+    std::ofstream out_stream;
+    if(argc > 2) {
+        out_stream.open(argv[2], std::ios::trunc);
+        if(!out_stream) error("Unable to create output file '" + std::string(argv[2]) + "'.");
+    }
+    std::ostream& out = (argc > 2 ? out_stream : std::cout);
+
+    wte::trace::header hdr;
+    if(!in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)) ||
+       std::memcmp(hdr.magic, wte::trace::MAGIC, sizeof(hdr.magic)) != 0)
+        error("'" + in_file + "' is not a message trace.");
+    if(hdr.version != wte::trace::VERSION)
+        error("Trace version " + std::to_string(hdr.version) + " not supported.");
+
+    std::unordered_map<uint32_t, std::string> strings = { { 0, "" } };
+    auto lookup = [&strings](const uint32_t& id) -> const std::string& {
+        auto it = strings.find(id);
+        if(it == strings.end()) error("Trace references unknown string " + std::to_string(id) + ".");
+        return it->second;
+    };
+
+    std::size_t count = 0;
+    wte::trace::entry_header ent;
+    std::vector<char> body;
+    while(in.read(reinterpret_cast<char*>(&ent), sizeof(ent))) {
+        if(ent.size < sizeof(ent)) error("Corrupt trace entry.");
+        body.resize(ent.size - sizeof(ent));
+        if(!in.read(body.data(), body.size())) {
+            std::cerr << "Warning:  trace ends with a partial entry." << std::endl;
+            break;
+        }
+
+        switch(ent.type) {
+            case wte::trace::ENTRY_STRING: {
+                uint32_t id;
+                if(body.size() < sizeof(id)) error("Corrupt string entry.");
+                std::memcpy(&id, body.data(), sizeof(id));
+                strings[id] = std::string(body.data() + sizeof(id), body.size() - sizeof(id));
+                break;
+            }
+            case wte::trace::ENTRY_MESSAGE: {
+                wte::trace::message_record rec;
+                if(body.size() < sizeof(rec)) error("Corrupt message entry.");
+                std::memcpy(&rec, body.data(), sizeof(rec));
+                if(body.size() - sizeof(rec) < uint64_t(rec.to_size) + rec.from_size + rec.args_size)
+                    error("Corrupt message entry.");
+                const char* to = body.data() + sizeof(rec);
+                const char* from = to + rec.to_size;
+                const char* args = from + rec.from_size;
+
+                if(rec.event == wte::trace::EVENT_DELETED) out << "MESSAGE DELETED | ";
+                out << "PROC AT:  " << rec.proc_time << " | ";
+                out << "TIMER:  " << rec.timer << " | ";
+                out << "SYS:  " << lookup(rec.sys) << " | ";
+                if(rec.to_size != 0 || rec.from_size != 0) {
+                    out << "TO:  ";
+                    out.write(to, rec.to_size);
+                    out << " | FROM:  ";
+                    out.write(from, rec.from_size);
+                    out << " | ";
+                }
+                out << "CMD:  " << lookup(rec.cmd) << " | ";
+                out << "ARGS:  ";
+                out.write(args, rec.args_size);
+                out << "\n";
+                count++;
+                break;
+            }
+            case wte::trace::ENTRY_DROPPED: {
+                uint64_t dropped;
+                if(body.size() < sizeof(dropped)) error("Corrupt dropped entry.");
+                std::memcpy(&dropped, body.data(), sizeof(dropped));
+                out << "TRACE DROPPED " << dropped << " RECORDS\n";
+                break;
+            }
+            default:
+                //  Unknown entry, skip it.
+                break;
+        }
+    }
+
+    out.flush();
+    std::cerr << count << " messages read from '" << in_file << "'." << std::endl;
+    return 0;
+}